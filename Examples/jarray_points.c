@@ -1,7 +1,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stddef.h>
 #include "../inc/jarray.h"
+#include "../inc/jarray_table.h"
 
 typedef struct {
     int x, y;
@@ -80,7 +82,7 @@ int main(void) {
     // --- Init with data ---
     Point data_start[5] = {{2,4}, {5,10}, {3,6}, {1,2}, {4,8}};
 
-    JARRAY_USER_CALLBACK_IMPLEMENTATION imp;
+    JARRAY_USER_CALLBACK_IMPLEMENTATION imp = {0};
 
     imp.print_element_callback = print_point;
     imp.element_to_string_callback = point_to_string;
@@ -178,6 +180,30 @@ int main(void) {
     JARRAY_CHECK_RET;
     jarray_print(&clone);
 
+    // --- Column table ---
+    printf("\nSplitting clone into x and y columns, sum of x: ");
+    JARRAY_TABLE_COLUMN columns[] = {
+        { offsetof(Point, x), sizeof(int), JARRAY_INT_PRESET },
+        { offsetof(Point, y), sizeof(int), JARRAY_INT_PRESET },
+    };
+    JARRAY_TABLE table;
+    jarray_table.from_array(&table, &clone, columns, 2);
+    JARRAY_CHECK_RET;
+    long long sum_x;
+    jarray.sum(jarray_table.column(&table, 0), &sum_x);
+    JARRAY_CHECK_RET;
+    printf("%lld\n", sum_x);
+    printf("Rows sorted by y: ");
+    jarray_table.sort_by_column(&table, 1, NULL);
+    JARRAY_CHECK_RET;
+    JARRAY sorted_by_y = jarray_table.to_array(&table);
+    JARRAY_CHECK_RET;
+    for (size_t i = 0; i < sorted_by_y._length; i++)
+        print_point(jarray_at(&sorted_by_y, i));
+    printf("\n");
+    jarray_free(&sorted_by_y);
+    jarray_table.free(&table);
+
     // --- Cleanup ---
     jarray_free(&points);
     jarray_free(&clone);
@@ -16,6 +16,7 @@
 #include <stdlib.h>
 #include <stdarg.h>
 #include <stdint.h>
+#include <stdio.h>
 
 #if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
     #define JARRAY_C11
@@ -41,6 +42,16 @@ extern "C" {
 #  define JARRAY_TYPEOF(x) typeof(x) /* C23 */
 #endif
 
+#if defined(JARRAY_C11)
+#  define JARRAY_THREAD_LOCAL _Thread_local
+#elif defined(__GNUC__) || defined(__clang__)
+#  define JARRAY_THREAD_LOCAL __thread
+#elif defined(_MSC_VER)
+#  define JARRAY_THREAD_LOCAL __declspec(thread)
+#else
+#  error "JARRAY needs thread-local storage for its error trace."
+#endif
+
 #if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L
 #  define JARRAY_DIRECT_INPUT(type, val) ((type[]){val})
 #else
@@ -69,7 +80,7 @@ extern "C" {
 #define JARRAY_GET_POINTER(type, val) ((type*)val)
 
 /**
- * @brief Checks if global error trace contains error.
+ * @brief Checks if the error trace of the calling thread contains error.
  *
  * @return true if error, false otherwise.
  */
@@ -211,6 +222,19 @@ extern "C" {
 #define jarray_contains(array, elem) \
     jarray.contains(array, JARRAY_GENERIC_DECLARE(elem))
 
+/**
+ * @brief Returns the index of the first element equal to `elem`.
+ *
+ * @note
+ * Uses the attached hash index if any (see `jarray_attach_hash_index`), otherwise scans with `is_equal_callback`.
+ *
+ * @param array Pointer to JARRAY.
+ * @param elem Element to search.
+ * @return index of the first match, or the length of the array if not found.
+ */
+#define jarray_index_of(array, elem) \
+    jarray.index_of(array, JARRAY_GENERIC_DECLARE(elem))
+
 /**
  * @brief Prints the error message of the last jarray call.
  * 
@@ -223,6 +247,14 @@ extern "C" {
 #define jarray_print_jarray_err(file, line) \
     jarray.print_jarray_err((file), (line))
 
+/**
+ * @brief Gets the message of the last jarray call of the calling thread.
+ * 
+ * @return message of the last error, "no error" if none.
+ */
+#define jarray_error_message() \
+    jarray.error_message()
+
 /**
  * @brief Frees a JARRAY instance and its internal data buffer.
  *
@@ -250,6 +282,17 @@ extern "C" {
 #define jarray_filter(array, predicate, ctx) \
     jarray.filter((array), (predicate), (ctx))
 
+/**
+ * @brief Filters elements based on a predicate into an existing jarray, reusing its buffer.
+ *
+ * @param array Pointer to JARRAY.
+ * @param dst Pointer to the destination JARRAY (may be `array` itself to filter in place).
+ * @param predicate Function returning true for elements to keep.
+ * @param ctx (Optionnal) Context pointer passed to predicate.
+ */
+#define jarray_filter_into(array, dst, predicate, ctx) \
+    jarray.filter_into((array), (dst), (predicate), (ctx))
+
 /**
  * @brief Retrieves a pointer to the element at a given index.
  *
@@ -344,6 +387,17 @@ extern "C" {
 #define jarray_print(array) \
     jarray.print((array))
 
+/**
+ * @brief Prints all elements to a stream, through a large buffer written with fwrite.
+ *
+ * @note Same text as `jarray_print`. Numeric presets are formatted without printf, other arrays need `element_format_callback` or `element_to_string_callback`.
+ *
+ * @param array Pointer to JARRAY.
+ * @param stream Stream to write to.
+ */
+#define jarray_print_to(array, stream) \
+    jarray.print_to((array), (stream))
+
 /**
  * @brief Sorts a copy of the array using a specified method.
  *
@@ -509,7 +563,7 @@ extern "C" {
 /**
  * @brief Joins the string representations of all elements into a single string, separated by a specified delimiter.
  * 
- * @note Uses the `element_to_string_callback` callback to convert each element to a string. Allocates memory for the resulting string; caller must free `.value`.
+ * @note Uses `element_format_callback` if set, `element_to_string_callback` otherwise. Allocates memory for the resulting string; caller must free it.
  * 
  * @param array Pointer to the JARRAY instance.
  * @param separator String to insert between elements.
@@ -518,6 +572,17 @@ extern "C" {
 #define jarray_join(array, separator) \
     jarray.join((array), (separator))
 
+/**
+ * @brief Streams the string representations of all elements, separated by a delimiter, to a writer.
+ * 
+ * @param array Pointer to the JARRAY instance.
+ * @param separator String to insert between elements.
+ * @param writer Function receiving `(data, size, ctx)` and returning the number of bytes it accepted.
+ * @param ctx (Optionnal) Context pointer for writer.
+ */
+#define jarray_write_to(array, separator, writer, ctx) \
+    jarray.write_to((array), (separator), (writer), (ctx))
+
 /**
  * @brief Reverses the order of elements in the array.
  * 
@@ -557,6 +622,17 @@ extern "C" {
 #define jarray_reduce_right(array, reducer, initial_value, ctx) \
     jarray.reduce_right((array), (reducer), (initial_value), (ctx))
 
+/**
+ * @brief Folds the array into a caller-owned accumulator of any type, updated in place by `fn`.
+ *
+ * @param array Pointer to JARRAY.
+ * @param acc Pointer to the accumulator, initialized by the caller.
+ * @param fn Function updating `acc` with `elem`.
+ * @param ctx (Optionnal) Context pointer for fn.
+ */
+#define jarray_fold(array, acc, fn, ctx) \
+    jarray.fold((array), (acc), (fn), (ctx))
+
 /**
  * @brief Finds the last element satisfying a predicate.
  *
@@ -630,6 +706,321 @@ extern "C" {
 #define jarray_init_reserve(array, elem_size, capacity, data_type, imp) \
     jarray.init_reserve((array), (elem_size), (capacity), (data_type), (imp))
 
+/**
+ * @brief Builds a hash index over the array, used by `contains`, `indexes_of` and `index_of`.
+ *
+ * @note
+ * Callbacks `hash_callback` and `is_equal_callback` must be set. The index is kept up to date by the functions modifying the array.
+ *
+ * @param array Pointer to JARRAY.
+ */
+#define jarray_attach_hash_index(array) \
+    jarray.attach_hash_index((array))
+
+/**
+ * @brief Frees the hash index attached to the array, if any.
+ *
+ * @param array Pointer to JARRAY.
+ */
+#define jarray_detach_hash_index(array) \
+    jarray.detach_hash_index((array))
+
+/**
+ * @brief Attaches a bloom filter to the array, letting lookups of absent elements skip the scan.
+ *
+ * @param array Pointer to JARRAY.
+ * @param bits_per_elem Number of bits per element (0 for default: 10, about 1% false positives).
+ */
+#define jarray_attach_bloom_filter(array, bits_per_elem) \
+    jarray.attach_bloom_filter((array), (bits_per_elem))
+
+/**
+ * @brief Rebuilds the bloom filter from the current elements (useful after many removals).
+ *
+ * @param array Pointer to JARRAY.
+ */
+#define jarray_rebuild_bloom_filter(array) \
+    jarray.rebuild_bloom_filter((array))
+
+/**
+ * @brief Frees the bloom filter attached to the array, if any.
+ *
+ * @param array Pointer to JARRAY.
+ */
+#define jarray_detach_bloom_filter(array) \
+    jarray.detach_bloom_filter((array))
+
+/**
+ * @brief Finds all indexes matching an element, as a JARRAY (`JARRAY_ULONG_PRESET`) sized to the number of matches.
+ *
+ * @param array Pointer to JARRAY.
+ * @param elem Element to find.
+ * @return jarray of the indexes, empty if there is no match.
+ */
+#define jarray_indexes_of_jarray(array, elem) \
+    jarray.indexes_of_jarray(array, JARRAY_GENERIC_DECLARE(elem))
+
+/**
+ * @brief Returns a bitmap of the elements matching `elem` (bit `i % 64` of word `i / 64` is set if element `i` matches).
+ *
+ * @param array Pointer to JARRAY.
+ * @param elem Element to find.
+ * @return pointer to the bitmap, caller must free it.
+ */
+#define jarray_matches_bitmap(array, elem) \
+    jarray.matches_bitmap(array, JARRAY_GENERIC_DECLARE(elem))
+
+/**
+ * @brief Counts the elements matching `elem`.
+ *
+ * @param array Pointer to JARRAY.
+ * @param elem Element to count.
+ * @return number of matches.
+ */
+#define jarray_count_of(array, elem) \
+    jarray.count_of(array, JARRAY_GENERIC_DECLARE(elem))
+
+/**
+ * @brief Calls `callback` for every element matching `elem`, in ascending index order, until it returns false.
+ *
+ * @param array Pointer to JARRAY.
+ * @param elem Element to find.
+ * @param callback Function receiving the index and a pointer to each match.
+ * @param ctx (Optionnal) Context pointer.
+ */
+#define jarray_for_each_match(array, elem, callback, ctx) \
+    jarray.for_each_match(array, JARRAY_GENERIC_DECLARE(elem), (callback), (ctx))
+
+/**
+ * @brief Checks which of `count` probes are in the array, setting bit `k % 64` of word `k / 64` of `out_bitmap` for each present probe `k`.
+ *
+ * @param array Pointer to JARRAY.
+ * @param probes Pointer to the probes, stored contiguously like the array's elements.
+ * @param count Number of probes.
+ * @param out_bitmap Caller allocated bitmap of `count / 64 + 1` words.
+ */
+#define jarray_contains_many(array, probes, count, out_bitmap) \
+    jarray.contains_many((array), (probes), (count), (out_bitmap))
+
+/**
+ * @brief Stores in `out_indexes[k]` the index of the first element equal to probe `k`, or the length of the array if absent.
+ *
+ * @param array Pointer to JARRAY.
+ * @param probes Pointer to the probes, stored contiguously like the array's elements.
+ * @param count Number of probes.
+ * @param out_indexes Caller allocated array of `count` indexes.
+ */
+#define jarray_index_of_many(array, probes, count, out_indexes) \
+    jarray.index_of_many((array), (probes), (count), (out_indexes))
+
+/**
+ * @brief Builds a new jarray holding `fn` applied to every element, with another element type.
+ *
+ * @param array Pointer to JARRAY.
+ * @param out_elem_size Size of the elements of the result.
+ * @param out_type Data type of the elements of the result.
+ * @param out_callbacks Callbacks of the result.
+ * @param fn Function writing the transformed element into `out`.
+ * @param ctx (Optionnal) Context pointer passed to fn.
+ * @return mapped jarray.
+ */
+#define jarray_map(array, out_elem_size, out_type, out_callbacks, fn, ctx) \
+    jarray.map((array), (out_elem_size), (out_type), (out_callbacks), (fn), (ctx))
+
+/**
+ * @brief Builds a new jarray of a preset type holding `fn` applied to every element.
+ *
+ * @param array Pointer to JARRAY.
+ * @param preset Preset of the result.
+ * @param fn Function writing the transformed element into `out`.
+ * @param ctx (Optionnal) Context pointer passed to fn.
+ * @return mapped jarray.
+ */
+#define jarray_map_preset(array, preset, fn, ctx) \
+    jarray.map_preset((array), (preset), (fn), (ctx))
+
+/**
+ * @brief Starts a lazy pipeline over the array. Stages are chained, then executed in a single pass by a terminal operation.
+ *
+ * @param array Pointer to JARRAY.
+ * @return pointer to the pipeline.
+ */
+#define jarray_pipeline(array) \
+    jarray.pipeline((array))
+
+/**
+ * @brief Sets the number of threads used by the parallel operations (0 for one per online processor).
+ *
+ * @param count Number of threads, the calling thread included.
+ */
+#define jarray_set_thread_count(count) \
+    jarray.set_thread_count((count))
+
+/**
+ * @brief Applies `callback` to every element, using the thread pool.
+ *
+ * @param array Pointer to JARRAY.
+ * @param callback Function to apply on each element.
+ * @param ctx (Optionnal) Context pointer.
+ */
+#define jarray_parallel_for_each(array, callback, ctx) \
+    jarray.parallel_for_each((array), (callback), (ctx))
+
+/**
+ * @brief Folds the array using the thread pool, partial accumulators being merged by `combine`.
+ *
+ * @param array Pointer to JARRAY.
+ * @param acc Pointer to the accumulator.
+ * @param acc_size Size of the accumulator.
+ * @param identity (Optionnal) Initial value of the partial accumulators.
+ * @param fn Function updating an accumulator with an element.
+ * @param combine Function merging a partial accumulator into another.
+ * @param ctx (Optionnal) Context pointer.
+ */
+#define jarray_parallel_fold(array, acc, acc_size, identity, fn, combine, ctx) \
+    jarray.parallel_fold((array), (acc), (acc_size), (identity), (fn), (combine), (ctx))
+
+/**
+ * @brief Filters elements using the thread pool, preserving their order.
+ *
+ * @param array Pointer to JARRAY.
+ * @param predicate Function returning true for elements to keep.
+ * @param ctx (Optionnal) Context pointer.
+ * @return filtered jarray.
+ */
+#define jarray_parallel_filter(array, predicate, ctx) \
+    jarray.parallel_filter((array), (predicate), (ctx))
+
+/**
+ * @brief Checks if any element matches `predicate`, using the thread pool.
+ *
+ * @param array Pointer to JARRAY.
+ * @param predicate Function to test each element.
+ * @param ctx (Optionnal) Context pointer.
+ * @return true if any element matches.
+ */
+#define jarray_parallel_any(array, predicate, ctx) \
+    jarray.parallel_any((array), (predicate), (ctx))
+
+/**
+ * @brief Finds the index of the first element matching `predicate`, using the thread pool.
+ *
+ * @param array Pointer to JARRAY.
+ * @param predicate Function to test each element.
+ * @param ctx (Optionnal) Context pointer.
+ * @return index of the first match, or the length of the array.
+ */
+#define jarray_parallel_find_first_index(array, predicate, ctx) \
+    jarray.parallel_find_first_index((array), (predicate), (ctx))
+
+/**
+ * @brief Sorts the array with a parallel merge sort.
+ *
+ * @param array Pointer to JARRAY.
+ * @param compare (Optionnal) Compare function, `compare_callback` of the array if NULL.
+ */
+#define jarray_parallel_sort(array, compare) \
+    jarray.parallel_sort((array), (compare))
+
+/**
+ * @brief Schedules `fn(arg)` as a task of `group` on the library scheduler.
+ *
+ * @param group Pointer to JARRAY_TASK_GROUP.
+ * @param fn Function of the task.
+ * @param arg Argument passed to fn.
+ */
+#define jarray_task_spawn(group, fn, arg) \
+    jarray.task_spawn((group), (fn), (arg))
+
+/**
+ * @brief Waits for every task of `group`, running pending tasks meanwhile.
+ *
+ * @param group Pointer to JARRAY_TASK_GROUP.
+ */
+#define jarray_task_wait(group) \
+    jarray.task_wait((group))
+
+/**
+ * @brief Multiplies every element of a numeric array by a literal factor.
+ *
+ * @param array Pointer to JARRAY.
+ * @param factor Factor (literal or variable) of the element type.
+ */
+#define jarray_scale(array, factor) \
+    jarray.scale((array), JARRAY_GENERIC_DECLARE(factor))
+
+/**
+ * @brief Computes `array[i] += alpha * other[i]` with a literal factor.
+ *
+ * @param array Pointer to JARRAY.
+ * @param alpha Factor (literal or variable) of the element type.
+ * @param other Pointer to a JARRAY of the same preset and length.
+ */
+#define jarray_axpy(array, alpha, other) \
+    jarray.axpy((array), JARRAY_GENERIC_DECLARE(alpha), (other))
+
+/**
+ * @brief Clamps every element of a numeric array between literal bounds.
+ *
+ * @param array Pointer to JARRAY.
+ * @param lo Lower bound (literal or variable) of the element type.
+ * @param hi Upper bound (literal or variable) of the element type.
+ */
+#define jarray_clamp(array, lo, hi) \
+    jarray.clamp((array), JARRAY_GENERIC_DECLARE(lo), JARRAY_GENERIC_DECLARE(hi))
+
+/**
+ * @brief Inclusive prefix sum of a numeric array, in place.
+ *
+ * @param array Pointer to JARRAY.
+ */
+#define jarray_cumsum(array) \
+    jarray.scan((array), NULL, JARRAY_SCAN_SUM, true)
+
+/**
+ * @brief Scans a numeric array with a built-in operation, in parallel.
+ *
+ * @param array Pointer to JARRAY.
+ * @param dst (Optionnal) Pointer to the destination JARRAY.
+ * @param op Built-in operation (JARRAY_SCAN_SUM, JARRAY_SCAN_PROD, JARRAY_SCAN_MIN, JARRAY_SCAN_MAX).
+ * @param inclusive Whether element i is part of output i.
+ */
+#define jarray_parallel_scan(array, dst, op, inclusive) \
+    jarray.parallel_scan((array), (dst), (op), (inclusive))
+
+/**
+ * @brief Groups the elements of an array by key and aggregates every group.
+ *
+ * @param array Pointer to JARRAY.
+ * @param params Pointer to JARRAY_GROUP_BY_PARAMS.
+ * @return a new JARRAY of entries.
+ */
+#define jarray_group_by(array, params) \
+    jarray.group_by((array), (params))
+
+/**
+ * @brief Counts the elements of an integer array into fixed bins.
+ *
+ * @param array Pointer to JARRAY.
+ * @param lo Lowest value of the first bin.
+ * @param width Number of values per bin.
+ * @param bins Number of bins.
+ * @param counts Pointer to `bins` counters.
+ */
+#define jarray_histogram(array, lo, width, bins, counts) \
+    jarray.histogram((array), (lo), (width), (bins), (counts))
+
+/**
+ * @brief Calls a callback once per contiguous block of elements.
+ *
+ * @param array Pointer to JARRAY.
+ * @param chunk_size Number of elements per block, a default size if 0.
+ * @param callback Function receiving `(chunk, count, start_index, ctx)`.
+ * @param ctx (Optionnal) Context pointer for callback.
+ */
+#define jarray_for_each_chunk(array, chunk_size, callback, ctx) \
+    jarray.for_each_chunk((array), (chunk_size), (callback), (ctx))
+
 #endif
 
 #define MAX_ERR_MSG_LENGTH 100
@@ -654,6 +1045,8 @@ typedef enum {
     JARRAY_ELEMENT_NOT_FOUND,
     JARRAY_INVALID_ARGUMENT,
     JARRAY_UNIMPLEMENTED_FUNCTION,
+    JARRAY_HASH_CALLBACK_UNINTIALIZED,
+    JARRAY_WRITE_FAILED,
 } JARRAY_ERROR;
 
 typedef enum {
@@ -678,6 +1071,7 @@ typedef enum {
  */
 typedef struct JARRAY_RETURN {
     JARRAY_ERROR error_code;
+    // Message of the last error. Left as is by successful calls: check `has_error` first, or use `jarray.error_message`.
     char error_msg[MAX_ERR_MSG_LENGTH];
     bool has_error;
     const JARRAY* ret_source;
@@ -699,6 +1093,10 @@ typedef struct JARRAY_USER_CALLBACK_IMPLEMENTATION {
     bool (*is_equal_callback)(const void*, const void*);
     // This function is MANDATORY if storing pointers (Example : strdup for char*).
     void *(*copy_elem_callback)(const void*);
+    // Function to hash an element. Elements equal for `is_equal_callback` must have the same hash. This function is mandatory if you want to use the jarray.attach_hash_index function.
+    size_t (*hash_callback)(const void*);
+    // Function to format an element into `buf` of `cap` bytes, snprintf-like: returns the length needed (without the terminator), writes nothing useful if it is >= cap. This function is NOT mandatory but lets join and write_to run without allocating per element.
+    size_t (*element_format_callback)(const void *elem, char *buf, size_t cap);
 } JARRAY_USER_CALLBACK_IMPLEMENTATION;
 
 typedef struct JARRAY_USER_OVERRIDE_IMPLEMENTATION {
@@ -708,6 +1106,41 @@ typedef struct JARRAY_USER_OVERRIDE_IMPLEMENTATION {
     void (*print_jarray_override)(const JARRAY*);
 }JARRAY_USER_OVERRIDE_IMPLEMENTATION;
 
+/// Hash index attached to a JARRAY (see `jarray.attach_hash_index`). Opaque, managed by the library.
+typedef struct JARRAY_HASH_INDEX JARRAY_HASH_INDEX;
+
+/// Bloom filter attached to a JARRAY (see `jarray.attach_bloom_filter`). Opaque, managed by the library.
+typedef struct JARRAY_BLOOM_FILTER JARRAY_BLOOM_FILTER;
+
+/// Lazy chain of stages over a JARRAY (see `jarray.pipeline`). Opaque, managed by the library.
+typedef struct JARRAY_PIPELINE JARRAY_PIPELINE;
+
+/// Group of tasks run by the library scheduler (see `jarray.task_group_create`). Opaque, managed by the library.
+typedef struct JARRAY_TASK_GROUP JARRAY_TASK_GROUP;
+
+/// Element produced by the `enumerate` stage of a pipeline.
+typedef struct JARRAY_ENUMERATED {
+    size_t index;           // position of the element in the stream reaching the stage
+    const void *value;      // pointer to the element
+} JARRAY_ENUMERATED;
+
+/**
+ * @brief Describes a `group_by`: how keys are extracted, hashed, compared, and how elements are aggregated.
+ *
+ * Result entries are `entry_size` bytes with the key at offset 0 and the aggregate at `agg_offset`,
+ * e.g. `struct { int key; long total; }` with `agg_offset = offsetof(ENTRY, total)`.
+ */
+typedef struct JARRAY_GROUP_BY_PARAMS {
+    size_t entry_size;                                          // size of a result entry
+    size_t key_size;                                            // size of a key, stored at offset 0 of an entry
+    size_t agg_offset;                                          // offset of the aggregate in an entry, at least key_size
+    void (*key_fn)(const void *elem, void *key, void *ctx);     // (Optionnal) writes the key of elem, the key is the first key_size bytes of elem if NULL
+    size_t (*hash_fn)(const void *key, void *ctx);              // (Optionnal) hashes a key, hashes its bytes if NULL
+    bool (*equals_fn)(const void *a, const void *b, void *ctx); // (Optionnal) compares two keys, compares their bytes if NULL
+    void (*agg_fn)(void *agg, const void *elem, void *ctx);     // (Optionnal) folds elem into the aggregate of its key, zeroed when the key is first seen
+    void *ctx;                                                  // (Optionnal) context pointer for the callbacks
+} JARRAY_GROUP_BY_PARAMS;
+
 typedef enum JARRAY_DATA_TYPE {
     JARRAY_TYPE_VALUE = 0,
     JARRAY_TYPE_POINTER
@@ -731,6 +1164,8 @@ typedef struct JARRAY {
     JARRAY_TYPE_PRESET _type_preset;
     JARRAY_USER_CALLBACK_IMPLEMENTATION user_callbacks;
     JARRAY_USER_OVERRIDE_IMPLEMENTATION user_overrides;
+    JARRAY_HASH_INDEX *_hash_index; // NULL unless attached with jarray.attach_hash_index
+    JARRAY_BLOOM_FILTER *_bloom_filter; // NULL unless attached with jarray.attach_bloom_filter
 } JARRAY;
 
 
@@ -742,6 +1177,17 @@ typedef enum SORT_METHOD {
     SELECTION_SORT,
 } SORT_METHOD;
 
+/**
+ * @brief Built-in associative operations of `scan` for numeric presets.
+ * Integer sums and products wrap around in the element type.
+ */
+typedef enum JARRAY_SCAN_OP {
+    JARRAY_SCAN_SUM = 0,
+    JARRAY_SCAN_PROD,
+    JARRAY_SCAN_MIN,
+    JARRAY_SCAN_MAX,
+} JARRAY_SCAN_OP;
+
 typedef struct JARRAY_INTERFACE {
     /**
      * @brief Prints the error message of the last jarray call.
@@ -753,6 +1199,15 @@ typedef struct JARRAY_INTERFACE {
      * @param line Line number of the error.
      */
     void (*print_jarray_err)(const char *file, int line);
+    /**
+     * @brief Gets the message of the last jarray call of the calling thread.
+     * 
+     * @note Returns "no error" after a successful call. Successful calls do not write any text, so `last_error_trace.error_msg` still holds the previous error.
+     * The string stays valid until the next jarray call of the thread.
+     * 
+     * @return message of the last error, "no error" if none.
+     */
+    const char* (*error_message)(void);
     /**
      * @brief Frees a JARRAY instance and its internal data buffer.
      *
@@ -767,7 +1222,7 @@ typedef struct JARRAY_INTERFACE {
      * @brief Filters elements based on a predicate.
      *
      * @note
-     * Allocates a new JARRAY for the filtered elements.
+     * Allocates a new JARRAY for the filtered elements. The predicate is called once per element.
      * Caller is responsible for freeing the new JARRAY and its data via `jarray.free` function.
      *
      * @param self Pointer to JARRAY.
@@ -776,6 +1231,20 @@ typedef struct JARRAY_INTERFACE {
      * @return filtered jarray.
      */
     JARRAY (*filter)(JARRAY *self, bool (*predicate)(const void *elem, const void *ctx), const void *ctx);
+    /**
+     * @brief Filters elements based on a predicate into an existing jarray.
+     *
+     * @note
+     * The previous content of `dst` is replaced, its buffer is reused and only grows, so calling it repeatedly with the
+     * same destination stops allocating once the buffer fits. `dst` must be initialized with the element size of `self`.
+     * If `dst` is `self`, the array is filtered in place.
+     *
+     * @param self Pointer to JARRAY.
+     * @param dst Pointer to the destination JARRAY.
+     * @param predicate Function returning true for elements to keep.
+     * @param ctx (Optionnal) Context pointer passed to predicate.
+     */
+    void (*filter_into)(JARRAY *self, JARRAY *dst, bool (*predicate)(const void *elem, const void *ctx), const void *ctx);
     /**
      * @brief Retrieves a pointer to the element at a given index.
      *
@@ -875,6 +1344,27 @@ typedef struct JARRAY_INTERFACE {
      * @param array Pointer to JARRAY.
      */
     void (*print)(const JARRAY *self);
+    /**
+     * @brief Prints all elements to a stream, through a large buffer written with fwrite.
+     *
+     * @note Same text as `print`, but `print_element_callback` and `print_jarray_override` are not used.
+     * Numeric presets are formatted without printf (integers two digits at a time, floats with two decimals in integer arithmetic).
+     * Other arrays are formatted with `element_format_callback` or `element_to_string_callback`, one of them must be set.
+     * Sets `JARRAY_WRITE_FAILED` if the stream does not take everything.
+     *
+     * @param self Pointer to JARRAY.
+     * @param stream Stream to write to.
+     */
+    void (*print_to)(const JARRAY *self, FILE *stream);
+    /**
+     * @brief Prints all elements to a file descriptor, through a large buffer written with write.
+     *
+     * @note Same as `print_to`, for a descriptor (pipe, socket, file opened with open). Partial writes are resumed.
+     *
+     * @param self Pointer to JARRAY.
+     * @param fd File descriptor to write to.
+     */
+    void (*print_fd)(const JARRAY *self, int fd);
     /**
      * @brief Sorts a copy of the array using a specified method.
      *
@@ -1036,13 +1526,26 @@ typedef struct JARRAY_INTERFACE {
     /**
      * @brief Joins the string representations of all elements into a single string, separated by a specified delimiter.
      * 
-     * @note Uses the `element_to_string_callback` callback to convert each element to a string. Allocates memory for the resulting string; caller must free `.value`.
+     * @note Uses `element_format_callback` if set, `element_to_string_callback` otherwise. The result is built in one pass into a growing buffer. Allocates memory for the resulting string; caller must free it.
      * 
      * @param self Pointer to the JARRAY instance.
      * @param separator String to insert between elements.
      * @return string result.
      */
     char* (*join)(JARRAY *self, const char *separator);
+    /**
+     * @brief Streams the string representations of all elements, separated by a delimiter, to a writer.
+     * 
+     * @note Same text as `join`, but nothing is kept past a fixed size buffer: it is handed to `writer` each time it fills up, and once at the end.
+     * With `element_format_callback` set, no allocation is made per element. An empty array writes nothing.
+     * Sets `JARRAY_WRITE_FAILED` if `writer` accepts less bytes than given, and stops there.
+     * 
+     * @param self Pointer to the JARRAY instance.
+     * @param separator String to insert between elements.
+     * @param writer Function receiving `(data, size, ctx)` and returning the number of bytes it accepted (fwrite-like).
+     * @param ctx (Optionnal) Context pointer for writer.
+     */
+    void (*write_to)(JARRAY *self, const char *separator, size_t (*writer)(const char *data, size_t size, void *ctx), void *ctx);
     /**
      * @brief Reverses the order of elements in the array.
      * 
@@ -1076,6 +1579,19 @@ typedef struct JARRAY_INTERFACE {
      * @return pointer to result.
      */
     void* (*reduce_right)(JARRAY *self, void* (*reducer)(const void* accumulator, const void* elem, const void* ctx), const void* initial_value, const void* ctx);
+    /**
+     * @brief Folds the array, from left to right, into a caller-owned accumulator updated in place.
+     *
+     * @note
+     * Unlike `reduce`, nothing is allocated and the accumulator may be of any type (e.g. a stats struct over an int array).
+     * Folding an empty array leaves the accumulator untouched.
+     *
+     * @param self Pointer to JARRAY.
+     * @param acc Pointer to the accumulator, initialized by the caller.
+     * @param fn Function updating `acc` with `elem`.
+     * @param ctx (Optionnal) Context pointer for fn.
+     */
+    void (*fold)(JARRAY *self, void *acc, void (*fn)(void *acc, const void *elem, void *ctx), void *ctx);
     /**
      * @brief Finds the last element satisfying a predicate.
      *
@@ -1177,14 +1693,762 @@ typedef struct JARRAY_INTERFACE {
      * @param capacity number of element to reserve in memory.
      */
     void (*init_reserve)(JARRAY *self, size_t elem_size, size_t capacity, JARRAY_DATA_TYPE data_type, JARRAY_USER_CALLBACK_IMPLEMENTATION imp);
-} JARRAY_INTERFACE;
-
-extern JARRAY_INTERFACE jarray;
-extern JARRAY_RETURN last_error_trace;
-
-/* ----- MACROS ----- */
-
-
+    /**
+     * @brief Builds a hash index over the array, used by `contains`, `indexes_of` and `index_of`.
+     *
+     * @note
+     * Callbacks `hash_callback` and `is_equal_callback` must be set. The index is maintained by `add`, `add_at`, `set`,
+     * `remove_at`, `splice`, `clear`... and rebuilt lazily after operations moving many elements (`sort`, `reverse`, `for_each`...).
+     * Lookups become O(1) on average instead of a full scan. Freed by `detach_hash_index` or `free`.
+     *
+     * @param self Pointer to JARRAY.
+     */
+    void (*attach_hash_index)(JARRAY *self);
+    /**
+     * @brief Frees the hash index attached to the array, if any.
+     *
+     * @param self Pointer to JARRAY.
+     */
+    void (*detach_hash_index)(JARRAY *self);
+    /**
+     * @brief Returns the index of the first element equal to `elem`.
+     *
+     * @note
+     * Uses the attached hash index if any, otherwise scans with `is_equal_callback`.
+     *
+     * @param self Pointer to JARRAY.
+     * @param elem Pointer to element to search.
+     * @return index of the first match, or the length of the array if not found.
+     */
+    size_t (*index_of)(JARRAY *self, const void *elem);
+    /**
+     * @brief Finds all indexes matching an element using `is_equal_callback`.
+     *
+     * @note
+     * Unlike `indexes_of`, the result is a JARRAY (`JARRAY_ULONG_PRESET`) holding only the indexes, sized to the number of matches.
+     * It is empty (not an error) if nothing matches. Caller must free it with `jarray.free`.
+     *
+     * @param self Pointer to JARRAY.
+     * @param elem Pointer to element to find.
+     * @return jarray of the indexes.
+     */
+    JARRAY (*indexes_of_jarray)(JARRAY *self, const void *elem);
+    /**
+     * @brief Returns a packed bitmap of the elements matching `elem`.
+     *
+     * @note
+     * Bit `i % 64` of word `i / 64` is set if element `i` matches. The bitmap holds `length / 64 + 1` words. Caller must free it.
+     *
+     * @param self Pointer to JARRAY.
+     * @param elem Pointer to element to find.
+     * @return pointer to the bitmap.
+     */
+    uint64_t* (*matches_bitmap)(JARRAY *self, const void *elem);
+    /**
+     * @brief Counts the elements matching `elem`, without allocating.
+     *
+     * @param self Pointer to JARRAY.
+     * @param elem Pointer to element to count.
+     * @return number of matches.
+     */
+    size_t (*count_of)(JARRAY *self, const void *elem);
+    /**
+     * @brief Streams the elements matching `elem` to `callback`, in ascending index order, without materializing them.
+     *
+     * @note
+     * Iteration stops as soon as `callback` returns false.
+     *
+     * @param self Pointer to JARRAY.
+     * @param elem Pointer to element to find.
+     * @param callback Function receiving the index and a pointer to each match.
+     * @param ctx (Optionnal) Context pointer.
+     */
+    void (*for_each_match)(JARRAY *self, const void *elem, bool (*callback)(size_t index, void *elem, void *ctx), void *ctx);
+    /**
+     * @brief Attaches a blocked bloom filter to the array.
+     *
+     * @note
+     * Callback `hash_callback` must be set. `contains`, `index_of`, `indexes_of`, `remove_all`... consult the filter first,
+     * so a lookup of an absent element costs one cache line instead of a full scan. The filter is updated on insertion.
+     * Removed elements stay in the filter (more false positives, never false negatives) until `rebuild_bloom_filter`.
+     *
+     * @param self Pointer to JARRAY.
+     * @param bits_per_elem Number of bits per element (0 for default: 10, about 1% false positives).
+     */
+    void (*attach_bloom_filter)(JARRAY *self, size_t bits_per_elem);
+    /**
+     * @brief Rebuilds the bloom filter from the current elements, resized for the current length.
+     *
+     * @param self Pointer to JARRAY.
+     */
+    void (*rebuild_bloom_filter)(JARRAY *self);
+    /**
+     * @brief Frees the bloom filter attached to the array, if any.
+     *
+     * @param self Pointer to JARRAY.
+     */
+    void (*detach_bloom_filter)(JARRAY *self);
+    /**
+     * @brief Checks the membership of many probes at once.
+     *
+     * @note
+     * Instead of one scan per probe, the lookup uses the attached hash index if any, otherwise it builds a temporary
+     * hash table on the smaller side (`hash_callback` set) or sorts the probes (`compare_callback` set), and resolves
+     * all probes in a single pass over the array. A handful of probes is simply scanned for.
+     * Unset callbacks must be NULL: zero-initialize the callbacks structure (`= {0}`) given to `jarray.init`.
+     * Bit `k % 64` of word `k / 64` of `out_bitmap` is set if probe `k` is in the array, other bits are cleared.
+     *
+     * @param self Pointer to JARRAY.
+     * @param probes Pointer to `count` probes, stored contiguously with the element size of the array.
+     * @param count Number of probes.
+     * @param out_bitmap Caller allocated bitmap of at least `count / 64 + 1` words.
+     */
+    void (*contains_many)(JARRAY *self, const void *probes, size_t count, uint64_t *out_bitmap);
+    /**
+     * @brief Finds the first index of many probes at once (same strategies as `contains_many`).
+     *
+     * @note Unset callbacks must be NULL: zero-initialize the callbacks structure (`= {0}`) given to `jarray.init`.
+     *
+     * @param self Pointer to JARRAY.
+     * @param probes Pointer to `count` probes, stored contiguously with the element size of the array.
+     * @param count Number of probes.
+     * @param out_indexes Caller allocated array of `count` indexes, `out_indexes[k]` is the length of the array if probe `k` is absent.
+     */
+    void (*index_of_many)(JARRAY *self, const void *probes, size_t count, size_t *out_indexes);
+    /**
+     * @brief Transforms every element into a new jarray, possibly of another element type.
+     *
+     * @note
+     * The result is allocated once with the exact length of `self`, and `fn` writes each transformed element
+     * directly into its slot (`out` points to `out_elem_size` uninitialized bytes).
+     * Caller is responsible for freeing the new JARRAY via `jarray.free` function.
+     *
+     * @param self Pointer to JARRAY.
+     * @param out_elem_size Size of the elements of the result.
+     * @param out_type Data type of the elements of the result (`copy_elem_callback` must be set in `out_callbacks` for `JARRAY_TYPE_POINTER`).
+     * @param out_callbacks Callbacks of the result.
+     * @param fn Function writing the transformation of `elem` into `out`.
+     * @param ctx (Optionnal) Context pointer passed to fn.
+     * @return mapped jarray.
+     */
+    JARRAY (*map)(JARRAY *self, size_t out_elem_size, JARRAY_DATA_TYPE out_type, JARRAY_USER_CALLBACK_IMPLEMENTATION out_callbacks, void (*fn)(const void *elem, void *out, void *ctx), void *ctx);
+    /**
+     * @brief Same as `map`, the result being initialized from a preset (element size, type and callbacks).
+     *
+     * @param self Pointer to JARRAY.
+     * @param preset Preset of the result.
+     * @param fn Function writing the transformation of `elem` into `out`.
+     * @param ctx (Optionnal) Context pointer passed to fn.
+     * @return mapped jarray.
+     */
+    JARRAY (*map_preset)(JARRAY *self, JARRAY_TYPE_PRESET preset, void (*fn)(const void *elem, void *out, void *ctx), void *ctx);
+    /**
+     * @brief Starts a lazy pipeline over the array.
+     *
+     * @note
+     * Stages (`pipeline_filter`, `pipeline_map`, `pipeline_take`, `pipeline_skip`, `pipeline_enumerate`) are only recorded.
+     * A terminal operation (`pipeline_collect`, `pipeline_reduce`, `pipeline_count`, `pipeline_any`, `pipeline_for_each`,
+     * `pipeline_first`) then runs all of them in a single pass, chunk by chunk, without intermediate arrays, and frees the pipeline.
+     * Stage functions return the pipeline to chain calls, or NULL on error (the pipeline is then freed, and terminals report the error).
+     * The array must not be modified while the pipeline exists.
+     *
+     * @param self Pointer to JARRAY.
+     * @return pointer to the pipeline.
+     */
+    JARRAY_PIPELINE* (*pipeline)(JARRAY *self);
+    /**
+     * @brief Adds a stage keeping only the elements matching `predicate`.
+     *
+     * @param pipeline Pointer to JARRAY_PIPELINE.
+     * @param predicate Function returning true for elements to keep.
+     * @param ctx (Optionnal) Context pointer passed to predicate.
+     * @return the pipeline.
+     */
+    JARRAY_PIPELINE* (*pipeline_filter)(JARRAY_PIPELINE *pipeline, bool (*predicate)(const void *elem, const void *ctx), const void *ctx);
+    /**
+     * @brief Adds a stage transforming every element, `fn` writing `out_elem_size` bytes into `out`.
+     *
+     * @param pipeline Pointer to JARRAY_PIPELINE.
+     * @param out_elem_size Size of the transformed elements.
+     * @param fn Function writing the transformation of `elem` into `out`.
+     * @param ctx (Optionnal) Context pointer passed to fn.
+     * @return the pipeline.
+     */
+    JARRAY_PIPELINE* (*pipeline_map)(JARRAY_PIPELINE *pipeline, size_t out_elem_size, void (*fn)(const void *elem, void *out, void *ctx), void *ctx);
+    /**
+     * @brief Adds a stage letting only the first `count` elements through. The source is not read past them.
+     *
+     * @param pipeline Pointer to JARRAY_PIPELINE.
+     * @param count Number of elements to keep.
+     * @return the pipeline.
+     */
+    JARRAY_PIPELINE* (*pipeline_take)(JARRAY_PIPELINE *pipeline, size_t count);
+    /**
+     * @brief Adds a stage dropping the first `count` elements.
+     *
+     * @param pipeline Pointer to JARRAY_PIPELINE.
+     * @param count Number of elements to drop.
+     * @return the pipeline.
+     */
+    JARRAY_PIPELINE* (*pipeline_skip)(JARRAY_PIPELINE *pipeline, size_t count);
+    /**
+     * @brief Adds a stage turning every element into a `JARRAY_ENUMERATED` (position in the stream and pointer to the element).
+     *
+     * @param pipeline Pointer to JARRAY_PIPELINE.
+     * @return the pipeline.
+     */
+    JARRAY_PIPELINE* (*pipeline_enumerate)(JARRAY_PIPELINE *pipeline);
+    /**
+     * @brief Sets the number of source elements processed per chunk (0 for default: 256).
+     *
+     * @param pipeline Pointer to JARRAY_PIPELINE.
+     * @param chunk_size Number of elements per chunk.
+     * @return the pipeline.
+     */
+    JARRAY_PIPELINE* (*pipeline_chunk_size)(JARRAY_PIPELINE *pipeline, size_t chunk_size);
+    /**
+     * @brief Runs the pipeline and stores its elements in a new jarray. Frees the pipeline.
+     *
+     * @param pipeline Pointer to JARRAY_PIPELINE.
+     * @param out_type Data type of the elements of the result.
+     * @param out_callbacks Callbacks of the result.
+     * @return collected jarray, caller must free it.
+     */
+    JARRAY (*pipeline_collect)(JARRAY_PIPELINE *pipeline, JARRAY_DATA_TYPE out_type, JARRAY_USER_CALLBACK_IMPLEMENTATION out_callbacks);
+    /**
+     * @brief Same as `pipeline_collect`, the result being initialized from a preset matching the size of the elements.
+     *
+     * @param pipeline Pointer to JARRAY_PIPELINE.
+     * @param preset Preset of the result.
+     * @return collected jarray, caller must free it.
+     */
+    JARRAY (*pipeline_collect_preset)(JARRAY_PIPELINE *pipeline, JARRAY_TYPE_PRESET preset);
+    /**
+     * @brief Runs the pipeline, folding every element into `acc` in place. Frees the pipeline.
+     *
+     * @param pipeline Pointer to JARRAY_PIPELINE.
+     * @param acc Pointer to the accumulator, initialized by the caller.
+     * @param fn Function updating `acc` with `elem`.
+     * @param ctx (Optionnal) Context pointer passed to fn.
+     */
+    void (*pipeline_reduce)(JARRAY_PIPELINE *pipeline, void *acc, void (*fn)(void *acc, const void *elem, void *ctx), void *ctx);
+    /**
+     * @brief Runs the pipeline and counts its elements. Frees the pipeline.
+     *
+     * @param pipeline Pointer to JARRAY_PIPELINE.
+     * @return number of elements.
+     */
+    size_t (*pipeline_count)(JARRAY_PIPELINE *pipeline);
+    /**
+     * @brief Runs the pipeline until an element matches `predicate` (or until any element if NULL). Frees the pipeline.
+     *
+     * @param pipeline Pointer to JARRAY_PIPELINE.
+     * @param predicate (Optionnal) Function returning true for the element searched.
+     * @param ctx (Optionnal) Context pointer passed to predicate.
+     * @return true if an element matched.
+     */
+    bool (*pipeline_any)(JARRAY_PIPELINE *pipeline, bool (*predicate)(const void *elem, const void *ctx), const void *ctx);
+    /**
+     * @brief Runs the pipeline, calling `callback` on every element. Frees the pipeline.
+     *
+     * @param pipeline Pointer to JARRAY_PIPELINE.
+     * @param callback Function called on each element.
+     * @param ctx (Optionnal) Context pointer passed to callback.
+     */
+    void (*pipeline_for_each)(JARRAY_PIPELINE *pipeline, void (*callback)(const void *elem, void *ctx), void *ctx);
+    /**
+     * @brief Runs the pipeline until its first element, copied into `out`. Frees the pipeline.
+     *
+     * @param pipeline Pointer to JARRAY_PIPELINE.
+     * @param out Pointer receiving the element (size of the elements produced by the last stage).
+     * @return true if an element was produced, false otherwise (`JARRAY_ELEMENT_NOT_FOUND`).
+     */
+    bool (*pipeline_first)(JARRAY_PIPELINE *pipeline, void *out);
+    /**
+     * @brief Frees a pipeline that is not run by a terminal operation.
+     *
+     * @param pipeline Pointer to JARRAY_PIPELINE.
+     */
+    void (*pipeline_free)(JARRAY_PIPELINE *pipeline);
+    /**
+     * @brief Sets the number of threads used by the parallel operations, the calling thread included.
+     *
+     * @note
+     * 0 (default) uses one thread per online processor, 1 runs parallel operations serially.
+     * The library-owned scheduler is started by the first parallel operation. Must not be called while one runs.
+     *
+     * @param count Number of threads.
+     */
+    void (*set_thread_count)(size_t count);
+    /**
+     * @brief Same as `for_each`, the array being split into chunks processed concurrently by the thread pool.
+     *
+     * @note
+     * `callback` is called from several threads at once, on distinct elements, in no particular order.
+     *
+     * @param self Pointer to JARRAY.
+     * @param callback Function to apply on each element.
+     * @param ctx (Optionnal) Context pointer, shared by all threads.
+     */
+    void (*parallel_for_each)(JARRAY *self, void (*callback)(void *elem, void *ctx), void *ctx);
+    /**
+     * @brief Parallel `fold`: every chunk is folded into its own accumulator, then the partial accumulators are combined into `acc`.
+     *
+     * @note
+     * Partial accumulators start as a copy of `identity` (zeroed if NULL) and are combined in chunk order,
+     * so `combine` needs to be associative but not commutative.
+     *
+     * @param self Pointer to JARRAY.
+     * @param acc Pointer to the accumulator, initialized by the caller.
+     * @param acc_size Size of the accumulator in bytes.
+     * @param identity (Optionnal) Initial value of the partial accumulators.
+     * @param fn Function updating an accumulator with `elem`.
+     * @param combine Function merging `partial` into `acc`.
+     * @param ctx (Optionnal) Context pointer for fn and combine, shared by all threads.
+     */
+    void (*parallel_fold)(JARRAY *self, void *acc, size_t acc_size, const void *identity, void (*fn)(void *acc, const void *elem, void *ctx), void (*combine)(void *acc, const void *partial, void *ctx), void *ctx);
+    /**
+     * @brief Parallel `filter`. The predicate is evaluated concurrently, the order of the elements is preserved.
+     *
+     * @param self Pointer to JARRAY.
+     * @param predicate Function returning true for elements to keep.
+     * @param ctx (Optionnal) Context pointer passed to predicate.
+     * @return filtered jarray, caller must free it.
+     */
+    JARRAY (*parallel_filter)(JARRAY *self, bool (*predicate)(const void *elem, const void *ctx), const void *ctx);
+    /**
+     * @brief Parallel `any`. All threads stop shortly after one of them finds a match.
+     *
+     * @param self Pointer to JARRAY.
+     * @param predicate Function to test each element.
+     * @param ctx (Optionnal) Context pointer for predicate.
+     * @return boolean : true if any satisfies the predicate, false otherwise.
+     */
+    bool (*parallel_any)(const JARRAY *self, bool (*predicate)(const void *elem, const void *ctx), const void *ctx);
+    /**
+     * @brief Parallel `find_first_index`. Threads scanning past a match already found stop early.
+     *
+     * @param self Pointer to JARRAY.
+     * @param predicate Function to test each element.
+     * @param ctx (Optionnal) Context pointer for predicate.
+     * @return index of the first matching element, or the length of the array if none.
+     */
+    size_t (*parallel_find_first_index)(JARRAY *self, bool (*predicate)(const void *elem, const void *ctx), const void *ctx);
+    /**
+     * @brief Sorts the array with a parallel merge sort running on the work-stealing scheduler.
+     *
+     * @param self Pointer to JARRAY.
+     * @param custom_compare_callback (Optionnal) Compare function, `compare_callback` of the array is used if NULL.
+     */
+    void (*parallel_sort)(JARRAY *self, int (*custom_compare_callback)(const void*, const void*));
+    /**
+     * @brief Creates a group of tasks run by the library scheduler, the one behind the parallel operations.
+     *
+     * @note
+     * The scheduler is work-stealing: each worker keeps its own deque of tasks and idle workers steal from the others,
+     * so tasks of very uneven cost and recursive (fork/join) work balance themselves.
+     *
+     * @return pointer to the group, NULL on allocation failure.
+     */
+    JARRAY_TASK_GROUP* (*task_group_create)(void);
+    /**
+     * @brief Schedules `fn(arg)` as a task of `group`.
+     *
+     * @note
+     * Can be called from any thread, including from a task or a parallel operation callback (nested parallelism).
+     * `arg` must stay valid until the task ran, i.e. until `task_wait` returns.
+     *
+     * @param group Pointer to JARRAY_TASK_GROUP.
+     * @param fn Function of the task.
+     * @param arg Argument passed to fn.
+     */
+    void (*task_spawn)(JARRAY_TASK_GROUP *group, void (*fn)(void *arg), void *arg);
+    /**
+     * @brief Waits for every task spawned in `group`. The calling thread runs pending tasks while waiting.
+     *
+     * @param group Pointer to JARRAY_TASK_GROUP.
+     */
+    void (*task_wait)(JARRAY_TASK_GROUP *group);
+    /**
+     * @brief Waits for every task spawned in `group`, then frees it.
+     *
+     * @param group Pointer to JARRAY_TASK_GROUP.
+     */
+    void (*task_group_free)(JARRAY_TASK_GROUP *group);
+    /**
+     * @brief Sums the elements of a numeric preset array.
+     *
+     * @note
+     * `out` must point to a `long long` for signed integer presets (INT, LONG, SHORT, CHAR), an `unsigned long long`
+     * for unsigned ones (UINT, ULONG, USHORT) and a `double` for FLOAT and DOUBLE: sums never overflow the element type.
+     * Integer sums past the range of the result wrap around modulo 2^64 (e.g. LONG elements near LONG_MAX).
+     * Runs a vectorized kernel (AVX2 picked at runtime when available).
+     *
+     * @param self Pointer to JARRAY.
+     * @param out Pointer to the sum.
+     */
+    void (*sum)(JARRAY *self, void *out);
+    /**
+     * @brief Arithmetic mean of the elements of a numeric preset array.
+     *
+     * @note Computed from a 128 bits integer sum, which cannot wrap, for integer presets.
+     *
+     * @param self Pointer to JARRAY.
+     * @return mean, 0 on error (empty array included).
+     */
+    double (*mean)(JARRAY *self);
+    /**
+     * @brief Smallest element of a numeric preset array (the first one on ties, NaN ignored).
+     *
+     * @note
+     * Returns a pointer to internal data; do NOT free.
+     *
+     * @param self Pointer to JARRAY.
+     * @return pointer to the element, NULL on error.
+     */
+    void* (*min)(JARRAY *self);
+    /**
+     * @brief Largest element of a numeric preset array (the first one on ties, NaN ignored).
+     *
+     * @note
+     * Returns a pointer to internal data; do NOT free.
+     *
+     * @param self Pointer to JARRAY.
+     * @return pointer to the element, NULL on error.
+     */
+    void* (*max)(JARRAY *self);
+    /**
+     * @brief Index of the smallest element of a numeric preset array (the first one on ties, NaN ignored).
+     *
+     * @param self Pointer to JARRAY.
+     * @return index of the element, 0 on error.
+     */
+    size_t (*argmin)(JARRAY *self);
+    /**
+     * @brief Index of the largest element of a numeric preset array (the first one on ties, NaN ignored).
+     *
+     * @param self Pointer to JARRAY.
+     * @return index of the element, 0 on error.
+     */
+    size_t (*argmax)(JARRAY *self);
+    /**
+     * @brief Dot product of two numeric arrays of the same preset and length.
+     *
+     * @param self Pointer to JARRAY.
+     * @param other Pointer to the other JARRAY.
+     * @param out Pointer to the result, of the same type as for `sum`, wrapping around like it.
+     */
+    void (*dot)(JARRAY *self, const JARRAY *other, void *out);
+    /**
+     * @brief Multiplies every element of a numeric array by `factor`, in place.
+     *
+     * @note
+     * Integer presets wrap around on overflow.
+     *
+     * @param self Pointer to JARRAY.
+     * @param factor Pointer to the factor, of the element type.
+     */
+    void (*scale)(JARRAY *self, const void *factor);
+    /**
+     * @brief Computes `self[i] += alpha * other[i]` in place.
+     *
+     * @param self Pointer to JARRAY.
+     * @param alpha Pointer to the factor, of the element type.
+     * @param other Pointer to a JARRAY of the same preset and length.
+     */
+    void (*axpy)(JARRAY *self, const void *alpha, const JARRAY *other);
+    /**
+     * @brief Computes `self[i] += other[i]` in place.
+     *
+     * @param self Pointer to JARRAY.
+     * @param other Pointer to a JARRAY of the same preset and length.
+     */
+    void (*add_array)(JARRAY *self, const JARRAY *other);
+    /**
+     * @brief Computes `self[i] -= other[i]` in place.
+     *
+     * @param self Pointer to JARRAY.
+     * @param other Pointer to a JARRAY of the same preset and length.
+     */
+    void (*sub_array)(JARRAY *self, const JARRAY *other);
+    /**
+     * @brief Computes `self[i] *= other[i]` in place.
+     *
+     * @param self Pointer to JARRAY.
+     * @param other Pointer to a JARRAY of the same preset and length.
+     */
+    void (*mul_array)(JARRAY *self, const JARRAY *other);
+    /**
+     * @brief Clamps every element of a numeric array into `[lo, hi]`, in place.
+     *
+     * @param self Pointer to JARRAY.
+     * @param lo Pointer to the lower bound, of the element type.
+     * @param hi Pointer to the upper bound, of the element type.
+     */
+    void (*clamp)(JARRAY *self, const void *lo, const void *hi);
+    /**
+     * @brief Prefix scan of a numeric preset array with a built-in operation.
+     *
+     * @note
+     * An inclusive scan writes `e0, e0 op e1, ...`, an exclusive one writes `identity, e0, e0 op e1, ...`
+     * (identity being 0 for SUM, 1 for PROD, the largest value for MIN and the lowest for MAX).
+     * The loop-carried dependency is one op per block of elements, so float sums may round differently from a strict
+     * left to right loop.
+     *
+     * @param self Pointer to JARRAY.
+     * @param dst (Optionnal) Pointer to the destination JARRAY, a value array of the same preset, overwritten and resized. Scans in place if NULL or self.
+     * @param op Built-in operation.
+     * @param inclusive Whether element i is part of output i.
+     */
+    void (*scan)(JARRAY *self, JARRAY *dst, JARRAY_SCAN_OP op, bool inclusive);
+    /**
+     * @brief Prefix scan of a value array with a custom associative operation.
+     *
+     * @param self Pointer to JARRAY.
+     * @param dst (Optionnal) Pointer to the destination JARRAY, a value array of the same element size, overwritten and resized. Scans in place if NULL or self.
+     * @param identity Pointer to the identity element of `op`.
+     * @param op Function computing `acc = acc op elem`, `acc` being an element.
+     * @param ctx (Optionnal) Context pointer for op.
+     * @param inclusive Whether element i is part of output i.
+     */
+    void (*scan_custom)(JARRAY *self, JARRAY *dst, const void *identity, void (*op)(void *acc, const void *elem, void *ctx), void *ctx, bool inclusive);
+    /**
+     * @brief Parallel `scan`: chunks are reduced on the thread pool, the chunk totals are scanned, then every chunk is scanned from its carry.
+     *
+     * @note
+     * Reads every element twice; pays off on large arrays with several threads.
+     *
+     * @param self Pointer to JARRAY.
+     * @param dst (Optionnal) Pointer to the destination JARRAY, of the same preset, scans in place if NULL or self.
+     * @param op Built-in operation.
+     * @param inclusive Whether element i is part of output i.
+     */
+    void (*parallel_scan)(JARRAY *self, JARRAY *dst, JARRAY_SCAN_OP op, bool inclusive);
+    /**
+     * @brief Parallel `scan_custom`. `op` is called concurrently and must be associative.
+     *
+     * @param self Pointer to JARRAY.
+     * @param dst (Optionnal) Pointer to the destination JARRAY, scans in place if NULL or self.
+     * @param identity Pointer to the identity element of `op`.
+     * @param op Function computing `acc = acc op elem`.
+     * @param ctx (Optionnal) Context pointer for op.
+     * @param inclusive Whether element i is part of output i.
+     */
+    void (*parallel_scan_custom)(JARRAY *self, JARRAY *dst, const void *identity, void (*op)(void *acc, const void *elem, void *ctx), void *ctx, bool inclusive);
+    /**
+     * @brief Groups the elements by key in a hash table and aggregates every group.
+     *
+     * @note
+     * Returns a value array of entries (key at offset 0, aggregate at `params->agg_offset`) in order of first occurrence
+     * of the keys, aggregates being updated in element order. No sort is needed.
+     *
+     * @param self Pointer to JARRAY.
+     * @param params Pointer to the description of the grouping.
+     * @return a new JARRAY of entries, to free with `jarray.free`.
+     */
+    JARRAY (*group_by)(JARRAY *self, const JARRAY_GROUP_BY_PARAMS *params);
+    /**
+     * @brief Parallel `group_by`: keys are hashed on the thread pool, then every hash partition is aggregated by one task.
+     *
+     * @note
+     * Partitions own disjoint keys, so no merge of aggregates is needed and every group still sees its elements in order.
+     * Entries come partition by partition (first occurrence order within a partition). Callbacks are called concurrently.
+     *
+     * @param self Pointer to JARRAY.
+     * @param params Pointer to the description of the grouping.
+     * @return a new JARRAY of entries, to free with `jarray.free`.
+     */
+    JARRAY (*parallel_group_by)(JARRAY *self, const JARRAY_GROUP_BY_PARAMS *params);
+    /**
+     * @brief Counts the elements of an integer preset array into `bins` fixed bins of `width` values starting at `lo`.
+     *
+     * @note
+     * Element `x` goes to bin `(x - lo) / width`; elements outside `[lo, lo + width * bins)` are not counted.
+     *
+     * @param self Pointer to JARRAY.
+     * @param lo Lowest value of the first bin (not negative for unsigned presets).
+     * @param width Number of values per bin.
+     * @param bins Number of bins.
+     * @param counts Pointer to `bins` counters, overwritten.
+     */
+    void (*histogram)(JARRAY *self, long long lo, size_t width, size_t bins, size_t *counts);
+    /**
+     * @brief Parallel `histogram`: every chunk is counted into its own bins on the thread pool, then the bins are summed.
+     *
+     * @param self Pointer to JARRAY.
+     * @param lo Lowest value of the first bin.
+     * @param width Number of values per bin.
+     * @param bins Number of bins.
+     * @param counts Pointer to `bins` counters, overwritten.
+     */
+    void (*parallel_histogram)(JARRAY *self, long long lo, size_t width, size_t bins, size_t *counts);
+    /**
+     * @brief Calls `callback` once per contiguous block of elements instead of once per element.
+     *
+     * @note
+     * The callback can run a tight (vectorizable) loop over `chunk[0..count)`, the elements `start_index..start_index + count`
+     * of the array. Every block has `chunk_size` elements except the last one.
+     *
+     * @param self Pointer to JARRAY.
+     * @param chunk_size Number of elements per block, a default size if 0.
+     * @param callback Function called on every block.
+     * @param ctx (Optionnal) Context pointer for callback.
+     */
+    void (*for_each_chunk)(JARRAY *self, size_t chunk_size, void (*callback)(void *chunk, size_t count, size_t start_index, void *ctx), void *ctx);
+    /**
+     * @brief Checks block by block if any element satisfies `predicate`, stopping at the first block for which it returns true.
+     *
+     * @param self Pointer to JARRAY.
+     * @param chunk_size Number of elements per block, a default size if 0.
+     * @param predicate Function returning true if an element of `chunk[0..count)` matches.
+     * @param ctx (Optionnal) Context pointer for predicate.
+     * @return true if a block matched.
+     */
+    bool (*any_chunk)(const JARRAY *self, size_t chunk_size, bool (*predicate)(const void *chunk, size_t count, size_t start_index, const void *ctx), const void *ctx);
+    /**
+     * @brief Finds the first matching element block by block.
+     *
+     * @note
+     * Returns a pointer to internal data; do NOT free.
+     *
+     * @param self Pointer to JARRAY.
+     * @param chunk_size Number of elements per block, a default size if 0.
+     * @param finder Function returning the position in `chunk` of its first matching element, or `count` if none.
+     * @param ctx (Optionnal) Context pointer for finder.
+     * @return pointer to the element found, NULL if none.
+     */
+    void* (*find_first_chunk)(JARRAY *self, size_t chunk_size, size_t (*finder)(const void *chunk, size_t count, size_t start_index, const void *ctx), const void *ctx);
+} JARRAY_INTERFACE;
+
+extern JARRAY_INTERFACE jarray;
+/**
+ * @brief Outcome of the last JARRAY call made by the calling thread.
+ *
+ * @note Each thread has its own trace: threads working on different arrays never see each other's errors.
+ * Callbacks and tasks run by the library scheduler execute on its worker threads, so errors they raise are not seen by the caller.
+ */
+extern JARRAY_THREAD_LOCAL JARRAY_RETURN last_error_trace;
+
+/* ----- MACROS ----- */
+
+/**
+ * @brief Mixes a 64 bits value into a well distributed hash. Can be used to implement `hash_callback`.
+ *
+ * @param x Value to hash.
+ * @return hash of `x`.
+ */
+static inline size_t jarray_hash_u64(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return (size_t)x;
+}
+
+/**
+ * @brief Hashes `size` bytes (FNV-1a). Can be used to implement `hash_callback` for strings or plain structures.
+ *
+ * @param data Pointer to the bytes to hash.
+ * @param size Number of bytes.
+ * @return hash of the bytes.
+ */
+static inline size_t jarray_hash_bytes(const void *data, size_t size) {
+    const unsigned char *bytes = (const unsigned char *)data;
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < size; i++) {
+        h ^= bytes[i];
+        h *= 0x100000001b3ULL;
+    }
+    return jarray_hash_u64(h);
+}
+
+/* ----- INLINE ACCESSORS ----- */
+
+/*
+ * Unchecked accessors for hot loops: they are inlined and never touch the error trace.
+ * Nothing is validated unless JARRAY_DEBUG is defined, in which case misuses fail an assert.
+ * Writing through them bypasses an attached hash index or bloom filter, use jarray.set on such arrays.
+ */
+
+#ifdef JARRAY_DEBUG
+#  include <assert.h>
+#  define JARRAY_DEBUG_ASSERT(cond) assert(cond)
+#else
+#  define JARRAY_DEBUG_ASSERT(cond) ((void)0)
+#endif
+
+/**
+ * @brief Gets the number of elements of the array.
+ *
+ * @param array Pointer to JARRAY.
+ * @return number of elements.
+ */
+static inline size_t jarray_len(const JARRAY *array) {
+    JARRAY_DEBUG_ASSERT(array != NULL);
+    return array->_length;
+}
+
+/**
+ * @brief Gets the buffer of the array. Valid until the array is resized.
+ *
+ * @param array Pointer to JARRAY.
+ * @return pointer to the first element, may be NULL if the array never held elements.
+ */
+static inline void *jarray_data(const JARRAY *array) {
+    JARRAY_DEBUG_ASSERT(array != NULL);
+    return array->_data;
+}
+
+/**
+ * @brief Gets a pointer to the element at `index`, without bound checking.
+ *
+ * @param array Pointer to JARRAY.
+ * @param index Index of the element, must be lower than the length.
+ * @return pointer to the element inside the array; do NOT free.
+ */
+static inline void *jarray_at_unchecked(const JARRAY *array, size_t index) {
+    JARRAY_DEBUG_ASSERT(array != NULL && index < array->_length);
+    return (char*)array->_data + index * array->_elem_size;
+}
+
+/**
+ * @brief Appends a copy of `elem`, in place when the capacity allows it.
+ *
+ * @note Call `jarray.reserve` first: while there is room and the array holds values without index nor bloom filter, this is a memcpy.
+ * Otherwise it falls back to `jarray.add`, which grows the array, copies pointers with `copy_elem_callback` and updates the attachments.
+ *
+ * @param array Pointer to JARRAY.
+ * @param elem Pointer to the element to append.
+ */
+static inline void jarray_push_unchecked(JARRAY *array, const void *elem) {
+    JARRAY_DEBUG_ASSERT(array != NULL && elem != NULL);
+    if (array->_length == array->_capacity || array->_data_type != JARRAY_TYPE_VALUE || array->_hash_index || array->_bloom_filter) {
+        jarray.add(array, elem);
+        return;
+    }
+    memcpy((char*)array->_data + array->_length * array->_elem_size, elem, array->_elem_size);
+    array->_length++;
+}
+
+/**
+ * @brief Element at `index` as a `type` lvalue, without bound checking.
+ *
+ * @note Indexes a `type*`, so `type` must be the element type (checked under JARRAY_DEBUG). Example: `JARRAY_AT(int, &arr, i) += 1;`
+ *
+ * @param type Type of the elements.
+ * @param array Pointer to JARRAY.
+ * @param index Index of the element, must be lower than the length.
+ */
+#ifdef JARRAY_DEBUG
+static inline void *jarray_debug_at(const JARRAY *array, size_t index, size_t type_size) {
+    JARRAY_DEBUG_ASSERT(array != NULL && type_size == array->_elem_size);
+    return jarray_at_unchecked(array, index);
+}
+#  define JARRAY_AT(type, array, index) (*(type*)jarray_debug_at((array), (index), sizeof(type)))
+#else
+#  define JARRAY_AT(type, array, index) (((type*)(array)->_data)[(index)])
+#endif
 
 #ifdef __cplusplus
 }
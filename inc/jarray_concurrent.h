@@ -0,0 +1,120 @@
+/**
+ * @file jarray_concurrent.h
+ * @brief Append-only array shared by many threads without locks.
+ * Elements live in buckets of doubling size that are never moved: a slot is reserved with an atomic fetch-add,
+ * the element is copied in place and stays at the same address until the array is freed.
+ * The length only covers the published prefix, the slots whose element is fully written, so readers can walk it
+ * while producers keep appending.
+ */
+
+#ifndef JARRAY_CONCURRENT_H
+#define JARRAY_CONCURRENT_H
+
+#include "jarray.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Concurrent append-only array (see `jarray_concurrent.create`). Opaque, managed by the library.
+typedef struct JARRAY_CONCURRENT JARRAY_CONCURRENT;
+
+typedef struct JARRAY_CONCURRENT_INTERFACE {
+    /**
+     * @brief Allocates an empty concurrent array.
+     *
+     * @note
+     * Caller is responsible for freeing it via `jarray_concurrent.free` function.
+     *
+     * @param elem_size Size of an element.
+     * @param data_type Type of the elements (value or pointer).
+     * @param user_callbacks Structure containing the implementation of callbacks functions, used for copies and `to_array`.
+     * @return pointer to the array, NULL on error.
+     */
+    JARRAY_CONCURRENT* (*create)(size_t elem_size, JARRAY_DATA_TYPE data_type, JARRAY_USER_CALLBACK_IMPLEMENTATION user_callbacks);
+    /**
+     * @brief Allocates an empty concurrent array of a preset type.
+     *
+     * @param preset Preset of the elements (e.g. JARRAY_INT_PRESET).
+     * @return pointer to the array, NULL on error.
+     */
+    JARRAY_CONCURRENT* (*create_preset)(JARRAY_TYPE_PRESET preset);
+    /**
+     * @brief Frees the array and its elements. No other thread may use it anymore.
+     *
+     * @param array Pointer to JARRAY_CONCURRENT.
+     */
+    void (*free)(JARRAY_CONCURRENT *array);
+    /**
+     * @brief Allocates the buckets up to `capacity` elements, so appends below it never allocate.
+     *
+     * @note Thread-safe. A failed bucket allocation during `push` leaves its slots unpublished for good, reserving ahead keeps allocations off the ingest path.
+     *
+     * @param array Pointer to JARRAY_CONCURRENT.
+     * @param capacity Number of elements to allocate room for.
+     */
+    void (*reserve)(JARRAY_CONCURRENT *array, size_t capacity);
+    /**
+     * @brief Appends a copy of `elem`. Thread-safe and lock-free.
+     *
+     * @note The element is visible to readers once every element before it is written too.
+     *
+     * @param array Pointer to JARRAY_CONCURRENT.
+     * @param elem Pointer to the element to append.
+     * @return index of the element, SIZE_MAX on error.
+     */
+    size_t (*push)(JARRAY_CONCURRENT *array, const void *elem);
+    /**
+     * @brief Appends copies of `count` contiguous elements, at consecutive indexes. Thread-safe and lock-free.
+     *
+     * @param array Pointer to JARRAY_CONCURRENT.
+     * @param elems Pointer to the first element to append.
+     * @param count Number of elements.
+     * @return index of the first element, SIZE_MAX on error.
+     */
+    size_t (*push_n)(JARRAY_CONCURRENT *array, const void *elems, size_t count);
+    /**
+     * @brief Length of the published prefix: every element below it is written and readable.
+     *
+     * @param array Pointer to JARRAY_CONCURRENT.
+     * @return number of published elements.
+     */
+    size_t (*length)(const JARRAY_CONCURRENT *array);
+    /**
+     * @brief Pointer to a published element. Thread-safe, the address never changes.
+     *
+     * @note
+     * Returns a pointer to internal data; do NOT free.
+     *
+     * @param array Pointer to JARRAY_CONCURRENT.
+     * @param index Index of the element, below the published length.
+     * @return pointer to the element, NULL on error.
+     */
+    void* (*at)(const JARRAY_CONCURRENT *array, size_t index);
+    /**
+     * @brief Calls `callback` on every element of the prefix published when the call starts, in order. Thread-safe.
+     *
+     * @param array Pointer to JARRAY_CONCURRENT.
+     * @param callback Function receiving `(elem, index, ctx)`.
+     * @param ctx (Optionnal) Context pointer for callback.
+     */
+    void (*for_each)(const JARRAY_CONCURRENT *array, void (*callback)(const void *elem, size_t index, void *ctx), void *ctx);
+    /**
+     * @brief Copies the published prefix into a new JARRAY, to use the rest of the `jarray` interface. Thread-safe.
+     *
+     * @note
+     * Caller is responsible for freeing the new JARRAY via `jarray.free` function.
+     *
+     * @param array Pointer to JARRAY_CONCURRENT.
+     * @return a new JARRAY with the same element type and callbacks.
+     */
+    JARRAY (*to_array)(const JARRAY_CONCURRENT *array);
+} JARRAY_CONCURRENT_INTERFACE;
+
+extern JARRAY_CONCURRENT_INTERFACE jarray_concurrent;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // JARRAY_CONCURRENT_H
@@ -0,0 +1,118 @@
+/**
+ * @file jarray_queue.h
+ * @brief Bounded FIFO ring buffers passing elements between threads, with the element layout and callbacks of a JARRAY.
+ * Unlike `jarray.add` + `jarray.shift`, a pop never moves the other elements and nothing is allocated after creation.
+ * JARRAY_QUEUE_SPSC: one producer thread and one consumer thread, both wait-free.
+ * JARRAY_QUEUE_MPMC: any number of producers and consumers, lock-free (per slot sequence numbers).
+ * Pushed elements are copied in (deep copied with `copy_elem_callback` for pointer elements), popped elements
+ * are moved out: the caller then owns what they point to.
+ */
+
+#ifndef JARRAY_QUEUE_H
+#define JARRAY_QUEUE_H
+
+#include "jarray.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Bounded ring-buffer queue (see `jarray_queue.create`). Opaque, managed by the library.
+typedef struct JARRAY_QUEUE JARRAY_QUEUE;
+
+typedef enum {
+    JARRAY_QUEUE_SPSC,   // a single producer thread and a single consumer thread
+    JARRAY_QUEUE_MPMC,   // any number of producer and consumer threads
+} JARRAY_QUEUE_MODE;
+
+typedef struct JARRAY_QUEUE_INTERFACE {
+    /**
+     * @brief Allocates an empty queue.
+     *
+     * @note
+     * Caller is responsible for freeing it via `jarray_queue.free` function.
+     *
+     * @param elem_size Size of an element.
+     * @param data_type Type of the elements (value or pointer).
+     * @param user_callbacks Structure containing the implementation of callbacks functions, used for copies.
+     * @param capacity Maximum number of queued elements, rounded up to a power of two.
+     * @param mode JARRAY_QUEUE_SPSC or JARRAY_QUEUE_MPMC.
+     * @return pointer to the queue, NULL on error.
+     */
+    JARRAY_QUEUE* (*create)(size_t elem_size, JARRAY_DATA_TYPE data_type, JARRAY_USER_CALLBACK_IMPLEMENTATION user_callbacks, size_t capacity, JARRAY_QUEUE_MODE mode);
+    /**
+     * @brief Allocates an empty queue of a preset type.
+     *
+     * @param preset Preset of the elements (e.g. JARRAY_INT_PRESET).
+     * @param capacity Maximum number of queued elements, rounded up to a power of two.
+     * @param mode JARRAY_QUEUE_SPSC or JARRAY_QUEUE_MPMC.
+     * @return pointer to the queue, NULL on error.
+     */
+    JARRAY_QUEUE* (*create_preset)(JARRAY_TYPE_PRESET preset, size_t capacity, JARRAY_QUEUE_MODE mode);
+    /**
+     * @brief Frees the queue and the elements left in it. No other thread may use it anymore.
+     *
+     * @param queue Pointer to JARRAY_QUEUE.
+     */
+    void (*free)(JARRAY_QUEUE *queue);
+    /**
+     * @brief Appends a copy of `elem` if the queue is not full.
+     *
+     * @note A full queue is not an error: the trace is left as it was.
+     *
+     * @param queue Pointer to JARRAY_QUEUE.
+     * @param elem Pointer to the element to append.
+     * @return true if the element was queued.
+     */
+    bool (*push)(JARRAY_QUEUE *queue, const void *elem);
+    /**
+     * @brief Removes the oldest element and moves it into `out`, if the queue is not empty.
+     *
+     * @note An empty queue is not an error: the trace is left as it was.
+     *
+     * @param queue Pointer to JARRAY_QUEUE.
+     * @param out Buffer of the element size receiving the element.
+     * @return true if an element was popped.
+     */
+    bool (*pop)(JARRAY_QUEUE *queue, void *out);
+    /**
+     * @brief Appends copies of up to `count` contiguous elements, as many as there is room for, in one step.
+     *
+     * @param queue Pointer to JARRAY_QUEUE.
+     * @param elems Pointer to the first element to append.
+     * @param count Number of elements.
+     * @return number of elements queued, from the start of `elems`.
+     */
+    size_t (*push_n)(JARRAY_QUEUE *queue, const void *elems, size_t count);
+    /**
+     * @brief Removes up to `max` of the oldest elements, in one step, and moves them into `out` in order.
+     *
+     * @param queue Pointer to JARRAY_QUEUE.
+     * @param out Buffer of `max` elements receiving the elements.
+     * @param max Maximum number of elements to pop.
+     * @return number of elements popped.
+     */
+    size_t (*pop_n)(JARRAY_QUEUE *queue, void *out, size_t max);
+    /**
+     * @brief Number of queued elements. Only a hint while other threads push or pop.
+     *
+     * @param queue Pointer to JARRAY_QUEUE.
+     * @return number of elements.
+     */
+    size_t (*length)(const JARRAY_QUEUE *queue);
+    /**
+     * @brief Maximum number of queued elements.
+     *
+     * @param queue Pointer to JARRAY_QUEUE.
+     * @return capacity, the one given at creation rounded up to a power of two.
+     */
+    size_t (*capacity)(const JARRAY_QUEUE *queue);
+} JARRAY_QUEUE_INTERFACE;
+
+extern JARRAY_QUEUE_INTERFACE jarray_queue;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // JARRAY_QUEUE_H
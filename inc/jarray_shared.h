@@ -0,0 +1,149 @@
+/**
+ * @file jarray_shared.h
+ * @brief JARRAY shared between threads behind a reader-writer lock, for read-mostly data.
+ * Reads (`get`, `contains`, `find_first`, `reduce`, `join`, ...) take the lock shared and run concurrently,
+ * mutations take it exclusive. With striping, `get` and `set` only lock the stripe of their index, so writers
+ * of different index ranges do not wait for each other.
+ * Results are copied out before the lock is released: nothing returned points inside the array.
+ * Every function leaves in `last_error_trace` the outcome of the jarray call it wrapped, for the calling thread.
+ */
+
+#ifndef JARRAY_SHARED_H
+#define JARRAY_SHARED_H
+
+#include "jarray.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// JARRAY guarded by a reader-writer lock (see `jarray_shared.create`). Opaque, managed by the library.
+typedef struct JARRAY_SHARED JARRAY_SHARED;
+
+typedef struct JARRAY_SHARED_INTERFACE {
+    /**
+     * @brief Wraps an array to share it between threads. The wrapper takes ownership of the array.
+     *
+     * @note
+     * Caller is responsible for freeing the wrapper via `jarray_shared.free` function.
+     * Striping speeds up concurrent `set` on different index ranges, but whole array reads then lock every stripe.
+     *
+     * @param array Array to share, not to be used directly anymore.
+     * @param stripes Number of index range locks, 0 or 1 for a single lock.
+     * @return pointer to the wrapper, NULL on error (the array then stays the caller's).
+     */
+    JARRAY_SHARED* (*create)(JARRAY array, size_t stripes);
+    /**
+     * @brief Frees the wrapper and its array. No other thread may use it anymore.
+     *
+     * @param shared Pointer to JARRAY_SHARED.
+     */
+    void (*free)(JARRAY_SHARED *shared);
+    /**
+     * @brief Runs `fn` on the array with the lock held shared. `fn` must not modify the array nor keep pointers inside it.
+     *
+     * @param shared Pointer to JARRAY_SHARED.
+     * @param fn Function receiving `(array, ctx)`.
+     * @param ctx (Optionnal) Context pointer for fn.
+     */
+    void (*read)(JARRAY_SHARED *shared, void (*fn)(JARRAY *array, void *ctx), void *ctx);
+    /**
+     * @brief Runs `fn` on the array with the lock held exclusive.
+     *
+     * @param shared Pointer to JARRAY_SHARED.
+     * @param fn Function receiving `(array, ctx)`.
+     * @param ctx (Optionnal) Context pointer for fn.
+     */
+    void (*write)(JARRAY_SHARED *shared, void (*fn)(JARRAY *array, void *ctx), void *ctx);
+    /**
+     * @brief Like `read`, but returns at once without running `fn` if a writer holds the lock.
+     *
+     * @return true if `fn` ran.
+     */
+    bool (*try_read)(JARRAY_SHARED *shared, void (*fn)(JARRAY *array, void *ctx), void *ctx);
+    /**
+     * @brief Like `write`, but returns at once without running `fn` if anyone holds the lock.
+     *
+     * @return true if `fn` ran.
+     */
+    bool (*try_write)(JARRAY_SHARED *shared, void (*fn)(JARRAY *array, void *ctx), void *ctx);
+    /**
+     * @brief Number of elements.
+     *
+     * @param shared Pointer to JARRAY_SHARED.
+     * @return length of the array.
+     */
+    size_t (*length)(JARRAY_SHARED *shared);
+    /**
+     * @brief Copies the element at `index` into `out`. Only locks the stripe of `index`.
+     *
+     * @note For pointer arrays the element is copied with `copy_elem_callback`, the caller owns the copy.
+     *
+     * @param shared Pointer to JARRAY_SHARED.
+     * @param index Index of the element.
+     * @param out Buffer of the element size receiving the copy.
+     * @return true if the element was copied.
+     */
+    bool (*get)(JARRAY_SHARED *shared, size_t index, void *out);
+    /**
+     * @brief Checks if the array contains an element, see `jarray.contains`.
+     */
+    bool (*contains)(JARRAY_SHARED *shared, const void *elem);
+    /**
+     * @brief Index of the first element equal to `elem`, see `jarray.index_of`.
+     */
+    size_t (*index_of)(JARRAY_SHARED *shared, const void *elem);
+    /**
+     * @brief Copies the first element satisfying `predicate` into `out`.
+     *
+     * @param shared Pointer to JARRAY_SHARED.
+     * @param predicate Function returning true for the element to find.
+     * @param ctx (Optionnal) Context pointer for predicate.
+     * @param out Buffer of the element size receiving the copy.
+     * @return true if an element was found.
+     */
+    bool (*find_first)(JARRAY_SHARED *shared, bool (*predicate)(const void *elem, const void *ctx), const void *ctx, void *out);
+    /**
+     * @brief Reduces the array, see `jarray.reduce`. Caller must free the result.
+     */
+    void* (*reduce)(JARRAY_SHARED *shared, void* (*reducer)(const void* accumulator, const void* elem, const void* ctx), const void* initial_value, const void* ctx);
+    /**
+     * @brief Joins the elements into a string, see `jarray.join`. Caller must free the result.
+     */
+    char* (*join)(JARRAY_SHARED *shared, const char *separator);
+    /**
+     * @brief Copies the whole array, to work on it without holding the lock.
+     *
+     * @note
+     * Caller is responsible for freeing the new JARRAY via `jarray.free` function.
+     */
+    JARRAY (*snapshot)(JARRAY_SHARED *shared);
+    /**
+     * @brief Appends a copy of an element, see `jarray.add`.
+     */
+    void (*add)(JARRAY_SHARED *shared, const void *elem);
+    /**
+     * @brief Replaces the element at `index`, see `jarray.set`. Only locks the stripe of `index` when no hash index nor bloom filter is attached.
+     */
+    void (*set)(JARRAY_SHARED *shared, size_t index, const void *elem);
+    /**
+     * @brief Removes the element at `index`, see `jarray.remove_at`.
+     */
+    void (*remove_at)(JARRAY_SHARED *shared, size_t index);
+    /**
+     * @brief Removes every element, see `jarray.clear`.
+     */
+    void (*clear)(JARRAY_SHARED *shared);
+    /**
+     * @brief Sorts the array, see `jarray.sort`.
+     */
+    void (*sort)(JARRAY_SHARED *shared, SORT_METHOD method, int (*custom_compare_callback)(const void*, const void*));
+} JARRAY_SHARED_INTERFACE;
+
+extern JARRAY_SHARED_INTERFACE jarray_shared;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // JARRAY_SHARED_H
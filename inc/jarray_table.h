@@ -0,0 +1,130 @@
+/**
+ * @file jarray_table.h
+ * @brief Column table (struct of arrays) built on JARRAY.
+ * A JARRAY_TABLE stores every field of a row type in its own JARRAY column, all columns sharing one length.
+ * Scans over one field then read contiguous memory, and numeric columns can use the numeric kernels of JARRAY directly.
+ * Rows are read and written as the original structure, through the layout given at init.
+ * Hash indexes and Bloom filters attached to a column are detached when the rows change.
+ */
+
+#ifndef JARRAY_TABLE_H
+#define JARRAY_TABLE_H
+
+#include "jarray.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Describes one column: where its field lives in a row and how the column is typed.
+ */
+typedef struct JARRAY_TABLE_COLUMN {
+    size_t offset;                  // offset of the field in a row, e.g. offsetof(Point, x)
+    size_t size;                    // size of the field
+    JARRAY_TYPE_PRESET preset;      // preset of the column (e.g. JARRAY_INT_PRESET), or JARRAY_NO_PRESET for raw bytes
+} JARRAY_TABLE_COLUMN;
+
+typedef struct JARRAY_TABLE {
+    JARRAY *_columns;               // one value JARRAY per column
+    JARRAY_TABLE_COLUMN *_layout;   // field of every column in a row
+    size_t _column_count;
+    size_t _row_size;               // size of a row structure
+    size_t _length;                 // number of rows, length of every column
+} JARRAY_TABLE;
+
+typedef struct JARRAY_TABLE_INTERFACE {
+    /**
+     * @brief Initializes an empty table with one column per field.
+     *
+     * @param table Pointer to JARRAY_TABLE.
+     * @param row_size Size of a row structure.
+     * @param columns Array of column descriptions, copied.
+     * @param column_count Number of columns.
+     */
+    void (*init)(JARRAY_TABLE *table, size_t row_size, const JARRAY_TABLE_COLUMN *columns, size_t column_count);
+    /**
+     * @brief Initializes a table from an array of structures (array of row structures), every row being split into the columns.
+     *
+     * @param table Pointer to JARRAY_TABLE.
+     * @param array Pointer to a value JARRAY whose elements are rows.
+     * @param columns Array of column descriptions, copied.
+     * @param column_count Number of columns.
+     */
+    void (*from_array)(JARRAY_TABLE *table, const JARRAY *array, const JARRAY_TABLE_COLUMN *columns, size_t column_count);
+    /**
+     * @brief Gathers the table back into an array of row structures. Bytes of a row not covered by a column are zero.
+     *
+     * @note
+     * Caller is responsible for freeing the new JARRAY via `jarray.free` function.
+     *
+     * @param table Pointer to JARRAY_TABLE.
+     * @return a new value JARRAY of rows.
+     */
+    JARRAY (*to_array)(const JARRAY_TABLE *table);
+    /**
+     * @brief Frees every column of the table.
+     *
+     * @param table Pointer to JARRAY_TABLE.
+     */
+    void (*free)(JARRAY_TABLE *table);
+    /**
+     * @brief Column JARRAY at `index`, to scan or aggregate one field (e.g. `jarray.sum(jarray_table.column(&t, 0), &total)`).
+     *
+     * @note
+     * Returns a pointer to internal data; do NOT free. Changing the length of a column breaks the table,
+     * modify rows through the table functions.
+     *
+     * @param table Pointer to JARRAY_TABLE.
+     * @param index Index of the column.
+     * @return pointer to the column, NULL on error.
+     */
+    JARRAY* (*column)(JARRAY_TABLE *table, size_t index);
+    /**
+     * @brief Appends a row, every field going to its column.
+     *
+     * @param table Pointer to JARRAY_TABLE.
+     * @param row Pointer to a row structure.
+     */
+    void (*add_row)(JARRAY_TABLE *table, const void *row);
+    /**
+     * @brief Copies the row at `index` into a row structure.
+     *
+     * @param table Pointer to JARRAY_TABLE.
+     * @param index Index of the row.
+     * @param row Pointer to the row structure to fill.
+     */
+    void (*get_row)(const JARRAY_TABLE *table, size_t index, void *row);
+    /**
+     * @brief Removes the row at `index` from every column, keeping the order of the other rows.
+     *
+     * @param table Pointer to JARRAY_TABLE.
+     * @param index Index of the row.
+     */
+    void (*remove_row)(JARRAY_TABLE *table, size_t index);
+    /**
+     * @brief Stable sort of the rows by the values of one column, every column being permuted the same way.
+     *
+     * @param table Pointer to JARRAY_TABLE.
+     * @param column Index of the sort column.
+     * @param compare (Optionnal) Compare function of two column values, `compare_callback` of the column if NULL.
+     */
+    void (*sort_by_column)(JARRAY_TABLE *table, size_t column, int (*compare)(const void*, const void*));
+    /**
+     * @brief Keeps the rows whose value in `column` satisfies `predicate`, in place and in order.
+     *
+     * @param table Pointer to JARRAY_TABLE.
+     * @param column Index of the tested column.
+     * @param predicate Function returning true for the values to keep.
+     * @param ctx (Optionnal) Context pointer for predicate.
+     */
+    void (*filter)(JARRAY_TABLE *table, size_t column, bool (*predicate)(const void *value, const void *ctx), const void *ctx);
+} JARRAY_TABLE_INTERFACE;
+
+extern JARRAY_TABLE_INTERFACE jarray_table;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // JARRAY_TABLE_H
@@ -0,0 +1,206 @@
+/**
+ * @file jarray_typed.h
+ * @brief Typed arrays generated at compile time on top of JARRAY.
+ * `JARRAY_DEFINE(int, jarray_i32)` declares a `jarray_i32` structure and `jarray_i32_xxx` inline functions
+ * where the element type is known: elements are read and written as `T`, and compare and equality are inlined.
+ * The structure only holds a `JARRAY base`, so `&arr.base` can be given to any function of the `jarray` interface.
+ *
+ * Generated functions for `JARRAY_DEFINE(T, name)`:
+ *   name name_init(void)                      empty array of T, with compare and is_equal callbacks set
+ *   name name_wrap(JARRAY array)              takes over a generic JARRAY of T (e.g. `jarray.init_preset(JARRAY_INT_PRESET)`)
+ *   void name_free(name *array)
+ *   JARRAY *name_base(name *array)            the generic array, for the `jarray` interface
+ *   size_t name_len(const name *array)
+ *   T *name_data(const name *array)
+ *   T name_at(const name *array, size_t i)    no bound check (asserted with JARRAY_DEBUG)
+ *   void name_reserve(name *array, size_t capacity)
+ *   void name_push(name *array, T value)
+ *   bool name_contains(const name *array, T value)
+ *   void name_sort(name *array)
+ *   name name_filter(const name *array, bool (*predicate)(T value, void *ctx), void *ctx)
+ *
+ * Like the inline accessors of jarray.h, they do not write the error trace, except when they fall back to the `jarray` interface.
+ */
+
+#ifndef JARRAY_TYPED_H
+#define JARRAY_TYPED_H
+
+#include "jarray.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define JARRAY_TYPED_DEFAULT_LESS(a, b) ((a) < (b))
+#define JARRAY_TYPED_DEFAULT_EQUAL(a, b) ((a) == (b))
+
+/// Ranges up to this length are sorted by insertion.
+#define JARRAY_TYPED_INSERTION_THRESHOLD 16
+
+/**
+ * @brief Declares a typed array of `T` named `name`, ordered with `<` and compared with `==`.
+ *
+ * @param T Element type, stored by value.
+ * @param name Name of the generated structure, prefix of the generated functions.
+ */
+#define JARRAY_DEFINE(T, name) \
+    JARRAY_DEFINE_EX(T, name, JARRAY_TYPED_DEFAULT_LESS, JARRAY_TYPED_DEFAULT_EQUAL)
+
+/**
+ * @brief Declares a typed array of `T` named `name` with custom ordering and equality.
+ *
+ * @param T Element type, stored by value.
+ * @param name Name of the generated structure, prefix of the generated functions.
+ * @param less Function or macro `less(T a, T b)`, true if `a` sorts before `b`.
+ * @param equal Function or macro `equal(T a, T b)`, true if `a` and `b` are equal.
+ */
+#define JARRAY_DEFINE_EX(T, name, less, equal)                                                              \
+    typedef struct name {                                                                                   \
+        JARRAY base;                                                                                        \
+    } name;                                                                                                 \
+                                                                                                            \
+    static inline int name##_compare_callback(const void *x, const void *y) {                               \
+        T a = *(const T*)x, b = *(const T*)y;                                                               \
+        return less(a, b) ? -1 : (less(b, a) ? 1 : 0);                                                      \
+    }                                                                                                       \
+                                                                                                            \
+    static inline bool name##_is_equal_callback(const void *x, const void *y) {                             \
+        return equal(*(const T*)x, *(const T*)y);                                                           \
+    }                                                                                                       \
+                                                                                                            \
+    static inline name name##_init(void) {                                                                  \
+        name array;                                                                                         \
+        JARRAY_USER_CALLBACK_IMPLEMENTATION imp = {0};                                                      \
+        imp.compare_callback = name##_compare_callback;                                                     \
+        imp.is_equal_callback = name##_is_equal_callback;                                                   \
+        jarray.init(&array.base, sizeof(T), JARRAY_TYPE_VALUE, imp);                                        \
+        return array;                                                                                       \
+    }                                                                                                       \
+                                                                                                            \
+    static inline name name##_wrap(JARRAY array) {                                                          \
+        JARRAY_DEBUG_ASSERT(array._elem_size == sizeof(T) && array._data_type == JARRAY_TYPE_VALUE);        \
+        name typed;                                                                                         \
+        typed.base = array;                                                                                 \
+        return typed;                                                                                       \
+    }                                                                                                       \
+                                                                                                            \
+    static inline void name##_free(name *array) { jarray.free(&array->base); }                              \
+    static inline JARRAY *name##_base(name *array) { return &array->base; }                                 \
+    static inline size_t name##_len(const name *array) { return array->base._length; }                      \
+    static inline T *name##_data(const name *array) { return (T*)array->base._data; }                       \
+    static inline void name##_reserve(name *array, size_t capacity) { jarray.reserve(&array->base, capacity); } \
+                                                                                                            \
+    static inline T name##_at(const name *array, size_t index) {                                            \
+        JARRAY_DEBUG_ASSERT(index < array->base._length);                                                   \
+        return ((const T*)array->base._data)[index];                                                        \
+    }                                                                                                       \
+                                                                                                            \
+    static inline void name##_push(name *array, T value) {                                                  \
+        JARRAY *base = &array->base;                                                                        \
+        if (base->_length == base->_capacity || base->_hash_index || base->_bloom_filter) {                 \
+            jarray.add(base, &value);                                                                       \
+            return;                                                                                         \
+        }                                                                                                   \
+        ((T*)base->_data)[base->_length++] = value;                                                         \
+    }                                                                                                       \
+                                                                                                            \
+    static inline bool name##_contains(const name *array, T value) {                                        \
+        /* An attached index answers without scanning */                                                    \
+        if (array->base._hash_index) return jarray.contains((JARRAY*)&array->base, &value);                 \
+        const T *data = (const T*)array->base._data;                                                        \
+        for (size_t i = 0; i < array->base._length; i++)                                                    \
+            if (equal(data[i], value)) return true;                                                         \
+        return false;                                                                                       \
+    }                                                                                                       \
+                                                                                                            \
+    static inline void name##_insertion_sort(T *data, size_t length) {                                      \
+        for (size_t i = 1; i < length; i++) {                                                               \
+            T value = data[i];                                                                              \
+            size_t j = i;                                                                                   \
+            for (; j > 0 && less(value, data[j - 1]); j--) data[j] = data[j - 1];                           \
+            data[j] = value;                                                                                \
+        }                                                                                                   \
+    }                                                                                                       \
+                                                                                                            \
+    static inline void name##_heap_sort(T *data, size_t length) {                                           \
+        for (size_t end = length, start = length / 2; end > 1;) {                                           \
+            if (start > 0) start--;                                                                         \
+            else { end--; T t = data[0]; data[0] = data[end]; data[end] = t; }                              \
+            T value = data[start];                                                                          \
+            size_t root = start;                                                                            \
+            for (size_t child; (child = 2 * root + 1) < end; root = child) {                                \
+                if (child + 1 < end && less(data[child], data[child + 1])) child++;                         \
+                if (!less(value, data[child])) break;                                                       \
+                data[root] = data[child];                                                                   \
+            }                                                                                               \
+            data[root] = value;                                                                             \
+        }                                                                                                   \
+    }                                                                                                       \
+                                                                                                            \
+    /* Introsort: median of three quicksort, heap sort past the depth limit, insertion sort on short ranges */ \
+    static inline void name##_sort_range(T *data, size_t length, size_t depth) {                            \
+        while (length > JARRAY_TYPED_INSERTION_THRESHOLD) {                                                 \
+            if (depth-- == 0) {                                                                             \
+                name##_heap_sort(data, length);                                                             \
+                return;                                                                                     \
+            }                                                                                               \
+            size_t mid = length / 2, last = length - 1;                                                     \
+            T t;                                                                                            \
+            if (less(data[mid], data[0])) { t = data[mid]; data[mid] = data[0]; data[0] = t; }              \
+            if (less(data[last], data[mid])) {                                                              \
+                t = data[mid]; data[mid] = data[last]; data[last] = t;                                      \
+                if (less(data[mid], data[0])) { t = data[mid]; data[mid] = data[0]; data[0] = t; }          \
+            }                                                                                               \
+            T pivot = data[mid];                                                                            \
+            size_t i = 0, j = last;                                                                         \
+            for (;;) {                                                                                      \
+                while (less(data[i], pivot)) i++;                                                           \
+                while (less(pivot, data[j])) j--;                                                           \
+                if (i >= j) break;                                                                          \
+                t = data[i]; data[i] = data[j]; data[j] = t;                                                \
+                i++;                                                                                        \
+                j--;                                                                                        \
+            }                                                                                               \
+            /* Recurse into the smaller side, loop on the larger one: the stack stays logarithmic */        \
+            size_t split = j + 1;                                                                           \
+            if (split < length - split) {                                                                   \
+                name##_sort_range(data, split, depth);                                                      \
+                data += split;                                                                              \
+                length -= split;                                                                            \
+            } else {                                                                                        \
+                name##_sort_range(data + split, length - split, depth);                                     \
+                length = split;                                                                             \
+            }                                                                                               \
+        }                                                                                                   \
+        name##_insertion_sort(data, length);                                                                \
+    }                                                                                                       \
+                                                                                                            \
+    static inline void name##_sort(name *array) {                                                           \
+        JARRAY *base = &array->base;                                                                        \
+        if (base->_length < 2) return;                                                                      \
+        /* jarray.sort keeps an attached index or bloom filter in sync */                                   \
+        if (base->_hash_index || base->_bloom_filter) {                                                     \
+            jarray.sort(base, QSORT, name##_compare_callback);                                              \
+            return;                                                                                         \
+        }                                                                                                   \
+        size_t depth = 0;                                                                                   \
+        for (size_t n = base->_length; n > 1; n >>= 1) depth += 2;                                          \
+        name##_sort_range((T*)base->_data, base->_length, depth);                                           \
+    }                                                                                                       \
+                                                                                                            \
+    static inline name name##_filter(const name *array, bool (*predicate)(T value, void *ctx), void *ctx) { \
+        name result = name##_init();                                                                        \
+        result.base.user_callbacks = array->base.user_callbacks;                                            \
+        result.base.user_overrides = array->base.user_overrides;                                            \
+        result.base._type_preset = array->base._type_preset;                                                \
+        const T *data = (const T*)array->base._data;                                                        \
+        for (size_t i = 0; i < array->base._length; i++)                                                    \
+            if (predicate(data[i], ctx)) name##_push(&result, data[i]);                                     \
+        return result;                                                                                      \
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // JARRAY_TYPED_H
@@ -1,6 +1,15 @@
 #include "../inc/jarray.h"
+#include "jarray_simd.h"
+#include "jarray_thread_pool.h"
+#include "jarray_numeric.h"
+#include "jarray_internal.h"
+#include "jarray_format.h"
 #include <stdio.h>
+#include <limits.h>
 #include <math.h>
+#include <stdatomic.h>
+#include <errno.h>
+#include <unistd.h>
 
 /**
  * @file jarray.c
@@ -8,7 +17,7 @@
  */
 
 /// Static error trace
-JARRAY_RETURN last_error_trace = {0};
+JARRAY_THREAD_LOCAL JARRAY_RETURN last_error_trace = {0};
 
 /// Lookup table mapping JARRAY_ERROR enum values to their corresponding string descriptions.
 static const char *enum_to_string[] = {
@@ -24,10 +33,18 @@ static const char *enum_to_string[] = {
     [JARRAY_IS_EQUAL_CALLBACK_UNINTIALIZED]             = "is_equal_callback callback not set",
     [JARRAY_ELEMENT_NOT_FOUND]                          = "Element not found",
     [JARRAY_UNIMPLEMENTED_FUNCTION]                     = "Function not implemented",
+    [JARRAY_HASH_CALLBACK_UNINTIALIZED]                 = "hash_callback callback not set",
+    [JARRAY_WRITE_FAILED]                               = "Writer failed",
 };
 
 static inline size_t max_size_t(size_t a, size_t b) {return (a > b ? a : b);}
 
+static int compare_callback_size_t(const void *a, const void *b) {
+    size_t val_a = *(const size_t*)a;
+    size_t val_b = *(const size_t*)b;
+    return (val_a > val_b) - (val_a < val_b);
+}
+
 static inline void* memcpy_elem(JARRAY *self, void *__restrict__ __dest, const void *__restrict__ __elem, size_t __count){
     void *ret = __dest;
 
@@ -62,9 +79,335 @@ static inline void* memcpy_elem(JARRAY *self, void *__restrict__ __dest, const v
     return ret;
 }
 
+/* ----- HASH INDEX ----- */
+
+/// Open addressing (linear probing) table mapping element hashes to element indexes.
+struct JARRAY_HASH_INDEX {
+    size_t *slots;      // index of the element + 1, 0 means empty slot
+    size_t *hashes;     // cached hash of the element referenced by the slot
+    size_t capacity;    // always a power of two
+    size_t count;
+    bool stale;         // set when the array changed too much to be tracked, rebuilt on next lookup
+};
+
+#define HASH_INDEX_MIN_CAPACITY 16
+
+static inline char* elem_at(const JARRAY *self, size_t index) {
+    return (char*)self->_data + index * self->_elem_size;
+}
+
+static bool hash_index_alloc(JARRAY_HASH_INDEX *index, size_t capacity) {
+    size_t *slots = calloc(capacity, sizeof(size_t));
+    size_t *hashes = malloc(capacity * sizeof(size_t));
+    if (!slots || !hashes) {
+        free(slots);
+        free(hashes);
+        return false;
+    }
+    free(index->slots);
+    free(index->hashes);
+    index->slots = slots;
+    index->hashes = hashes;
+    index->capacity = capacity;
+    index->count = 0;
+    return true;
+}
+
+static void hash_index_place(JARRAY_HASH_INDEX *index, size_t hash, size_t slot_value) {
+    size_t mask = index->capacity - 1;
+    size_t pos = hash & mask;
+    while (index->slots[pos] != 0)
+        pos = (pos + 1) & mask;
+    index->slots[pos] = slot_value;
+    index->hashes[pos] = hash;
+    index->count++;
+}
+
+static bool hash_index_grow(JARRAY_HASH_INDEX *index) {
+    size_t *old_slots = index->slots;
+    size_t *old_hashes = index->hashes;
+    size_t old_capacity = index->capacity;
+
+    index->slots = NULL;
+    index->hashes = NULL;
+    if (!hash_index_alloc(index, old_capacity * 2)) {
+        index->slots = old_slots;
+        index->hashes = old_hashes;
+        return false;
+    }
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old_slots[i] != 0)
+            hash_index_place(index, old_hashes[i], old_slots[i]);
+    }
+    free(old_slots);
+    free(old_hashes);
+    return true;
+}
+
+static bool hash_index_rebuild(JARRAY *self) {
+    JARRAY_HASH_INDEX *index = self->_hash_index;
+    size_t capacity = HASH_INDEX_MIN_CAPACITY;
+    while (capacity * 3 < self->_length * 4)
+        capacity *= 2;
+
+    if (capacity != index->capacity || !index->slots) {
+        if (!hash_index_alloc(index, capacity)) return false;
+    } else {
+        memset(index->slots, 0, capacity * sizeof(size_t));
+        index->count = 0;
+    }
+    for (size_t i = 0; i < self->_length; i++)
+        hash_index_place(index, self->user_callbacks.hash_callback(elem_at(self, i)), i + 1);
+    index->stale = false;
+    return true;
+}
+
+static inline bool hash_index_tracking(const JARRAY *self) {
+    return self->_hash_index && !self->_hash_index->stale;
+}
+
+/// Registers the element stored at `pos`.
+static void hash_index_insert(JARRAY *self, size_t pos) {
+    if (!hash_index_tracking(self)) return;
+    JARRAY_HASH_INDEX *index = self->_hash_index;
+    if ((index->count + 1) * 4 > index->capacity * 3 && !hash_index_grow(index)) {
+        index->stale = true;
+        return;
+    }
+    hash_index_place(index, self->user_callbacks.hash_callback(elem_at(self, pos)), pos + 1);
+}
+
+/// Unregisters the element stored at `pos`. Must be called before the element is overwritten or moved.
+static void hash_index_erase(JARRAY *self, size_t pos) {
+    if (!hash_index_tracking(self)) return;
+    JARRAY_HASH_INDEX *index = self->_hash_index;
+    size_t mask = index->capacity - 1;
+    size_t hole = self->user_callbacks.hash_callback(elem_at(self, pos)) & mask;
+
+    while (index->slots[hole] != 0 && index->slots[hole] != pos + 1)
+        hole = (hole + 1) & mask;
+    if (index->slots[hole] == 0) return;
+
+    // Backward shift deletion keeps the probe sequences valid without tombstones
+    size_t next = (hole + 1) & mask;
+    while (index->slots[next] != 0) {
+        size_t home = index->hashes[next] & mask;
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            index->slots[hole] = index->slots[next];
+            index->hashes[hole] = index->hashes[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    index->slots[hole] = 0;
+    index->count--;
+}
+
+/// Adds `delta` to every registered index greater or equal to `from` (elements moved by an insertion or a removal).
+static void hash_index_shift(JARRAY *self, size_t from, long delta) {
+    if (!hash_index_tracking(self)) return;
+    JARRAY_HASH_INDEX *index = self->_hash_index;
+    for (size_t i = 0; i < index->capacity; i++) {
+        if (index->slots[i] > from)
+            index->slots[i] += delta;
+    }
+}
+
+static void hash_index_reset(JARRAY *self) {
+    if (!self->_hash_index) return;
+    JARRAY_HASH_INDEX *index = self->_hash_index;
+    if (index->slots)
+        memset(index->slots, 0, index->capacity * sizeof(size_t));
+    index->count = 0;
+    index->stale = false;
+}
+
+static inline void hash_index_invalidate(JARRAY *self) {
+    if (self->_hash_index) self->_hash_index->stale = true;
+}
+
+static bool hash_index_ready(JARRAY *self) {
+    if (!self->_hash_index) return false;
+    if (self->_hash_index->stale && !hash_index_rebuild(self)) return false;
+    return true;
+}
+
+/**
+ * Calls `visitor` with the index of every element equal to `elem`, in no particular order.
+ * Stops as soon as `visitor` returns false.
+ */
+static void hash_index_lookup(JARRAY *self, const void *elem, bool (*visitor)(size_t index, void *ctx), void *ctx) {
+    JARRAY_HASH_INDEX *index = self->_hash_index;
+    size_t hash = self->user_callbacks.hash_callback(elem);
+    size_t mask = index->capacity - 1;
+    for (size_t pos = hash & mask; index->slots[pos] != 0; pos = (pos + 1) & mask) {
+        if (index->hashes[pos] != hash) continue;
+        size_t i = index->slots[pos] - 1;
+        if (self->user_callbacks.is_equal_callback(elem_at(self, i), elem) && !visitor(i, ctx))
+            return;
+    }
+}
+
+static bool visit_min_index(size_t index, void *ctx) {
+    size_t *min = ctx;
+    if (index < *min) *min = index;
+    return true;
+}
+
+static bool visit_any_index(size_t index, void *ctx) {
+    (void)index;
+    *(bool*)ctx = true;
+    return false;
+}
+
+/// Growable buffer of indexes filled by the match visitors.
+typedef struct INDEX_BUFFER {
+    size_t *indexes;
+    size_t count;
+    size_t capacity;
+    bool failed;
+} INDEX_BUFFER;
+
+static bool visit_buffer_index(size_t index, void *ctx) {
+    INDEX_BUFFER *buffer = ctx;
+    if (buffer->count == buffer->capacity) {
+        size_t new_cap = buffer->capacity ? buffer->capacity * 2 : 8;
+        size_t *new_indexes = realloc(buffer->indexes, new_cap * sizeof(size_t));
+        if (!new_indexes) {
+            buffer->failed = true;
+            return false;
+        }
+        buffer->indexes = new_indexes;
+        buffer->capacity = new_cap;
+    }
+    buffer->indexes[buffer->count++] = index;
+    return true;
+}
+
+static void hash_index_destroy(JARRAY *self) {
+    if (!self->_hash_index) return;
+    free(self->_hash_index->slots);
+    free(self->_hash_index->hashes);
+    free(self->_hash_index);
+    self->_hash_index = NULL;
+}
+
+/* ----- BLOOM FILTER ----- */
+
+#define BLOOM_BLOCK_WORDS 8             // 512 bits blocks: a lookup touches a single cache line
+#define BLOOM_BLOCK_BITS (BLOOM_BLOCK_WORDS * 64)
+#define BLOOM_HASHES 7                  // 7 positions of 9 bits taken from one 64 bits hash
+#define BLOOM_DEFAULT_BITS_PER_ELEM 10
+
+/// Blocked Bloom filter answering "definitely absent" without scanning the array.
+struct JARRAY_BLOOM_FILTER {
+    uint64_t *blocks;
+    size_t block_count;     // always a power of two
+    size_t bits_per_elem;
+    size_t sized_for;       // number of elements the filter was sized for
+    size_t inserted;        // insertions since the last rebuild
+    bool stale;             // rebuilt before the next lookup
+};
+
+static inline uint64_t* bloom_block(const JARRAY_BLOOM_FILTER *filter, uint64_t mixed) {
+    return filter->blocks + (mixed & (filter->block_count - 1)) * BLOOM_BLOCK_WORDS;
+}
+
+static void bloom_add_hash(JARRAY_BLOOM_FILTER *filter, size_t hash) {
+    uint64_t mixed = jarray_hash_u64(hash);
+    uint64_t *block = bloom_block(filter, mixed);
+    uint64_t bits = jarray_hash_u64(mixed ^ 0x9e3779b97f4a7c15ULL);
+    for (int i = 0; i < BLOOM_HASHES; i++, bits >>= 9)
+        block[(bits & (BLOOM_BLOCK_BITS - 1)) / 64] |= (uint64_t)1 << (bits % 64);
+}
+
+static bool bloom_test_hash(const JARRAY_BLOOM_FILTER *filter, size_t hash) {
+    uint64_t mixed = jarray_hash_u64(hash);
+    const uint64_t *block = bloom_block(filter, mixed);
+    uint64_t bits = jarray_hash_u64(mixed ^ 0x9e3779b97f4a7c15ULL);
+    for (int i = 0; i < BLOOM_HASHES; i++, bits >>= 9) {
+        if (!(block[(bits & (BLOOM_BLOCK_BITS - 1)) / 64] & ((uint64_t)1 << (bits % 64))))
+            return false;
+    }
+    return true;
+}
+
+static bool bloom_rebuild(JARRAY *self) {
+    JARRAY_BLOOM_FILTER *filter = self->_bloom_filter;
+    size_t sized_for = max_size_t(self->_length, 64);
+    size_t wanted_blocks = (sized_for * filter->bits_per_elem + BLOOM_BLOCK_BITS - 1) / BLOOM_BLOCK_BITS;
+    size_t block_count = 1;
+    while (block_count < wanted_blocks)
+        block_count *= 2;
+
+    if (block_count != filter->block_count || !filter->blocks) {
+        uint64_t *blocks = calloc(block_count * BLOOM_BLOCK_WORDS, sizeof(uint64_t));
+        if (!blocks) return false;
+        free(filter->blocks);
+        filter->blocks = blocks;
+        filter->block_count = block_count;
+    } else {
+        memset(filter->blocks, 0, block_count * BLOOM_BLOCK_WORDS * sizeof(uint64_t));
+    }
+    for (size_t i = 0; i < self->_length; i++)
+        bloom_add_hash(filter, self->user_callbacks.hash_callback(elem_at(self, i)));
+    filter->sized_for = sized_for;
+    filter->inserted = 0;
+    filter->stale = false;
+    return true;
+}
+
+static void bloom_insert(JARRAY *self, size_t pos) {
+    JARRAY_BLOOM_FILTER *filter = self->_bloom_filter;
+    if (!filter || filter->stale) return;
+    bloom_add_hash(filter, self->user_callbacks.hash_callback(elem_at(self, pos)));
+    // Past twice the planned size the false positive rate climbs: resize on next lookup
+    if (++filter->inserted > filter->sized_for * 2)
+        filter->stale = true;
+}
+
+/// Returns false only if `elem` is definitely not in the array. Always true without filter.
+static bool bloom_may_contain(JARRAY *self, const void *elem) {
+    JARRAY_BLOOM_FILTER *filter = self->_bloom_filter;
+    if (!filter) return true;
+    if (filter->stale && !bloom_rebuild(self)) return true;
+    return bloom_test_hash(filter, self->user_callbacks.hash_callback(elem));
+}
+
+static void bloom_reset(JARRAY *self) {
+    JARRAY_BLOOM_FILTER *filter = self->_bloom_filter;
+    if (!filter) return;
+    if (filter->blocks)
+        memset(filter->blocks, 0, filter->block_count * BLOOM_BLOCK_WORDS * sizeof(uint64_t));
+    filter->inserted = 0;
+    filter->stale = false;
+}
+
+static inline void bloom_invalidate(JARRAY *self) {
+    if (self->_bloom_filter) self->_bloom_filter->stale = true;
+}
+
+static void bloom_destroy(JARRAY *self) {
+    if (!self->_bloom_filter) return;
+    free(self->_bloom_filter->blocks);
+    free(self->_bloom_filter);
+    self->_bloom_filter = NULL;
+}
+
+/// Registers the element stored at `pos` in the attached lookup structures.
+static inline void track_insert(JARRAY *self, size_t pos) {
+    hash_index_insert(self, pos);
+    bloom_insert(self, pos);
+}
+
+
+static const char *error_message(void) {
+    if (!last_error_trace.has_error) return "no error";
+    return last_error_trace.error_msg;
+}
 
 static void print_array_err(const char *file, int line) {
-    if (last_error_trace.ret_source->user_overrides.print_error_override) {
+    if (last_error_trace.ret_source && last_error_trace.ret_source->user_overrides.print_error_override) {
         last_error_trace.ret_source->user_overrides.print_error_override(last_error_trace);
         return;
     }
@@ -74,35 +417,41 @@ static void print_array_err(const char *file, int line) {
     } else {
         fprintf(stderr, "%s:%d [\033[31mError: %s\033[0m] : ", file, line, enum_to_string[last_error_trace.error_code]);
     }
-    fprintf(stderr, "%s\n", last_error_trace.error_msg);
+    fprintf(stderr, "%s\n", error_message());
+}
+
+/// Frees the pointers stored by the elements `[start, end)` of a `JARRAY_TYPE_POINTER` array.
+static void free_pointer_elems(JARRAY *array, size_t start, size_t end) {
+    for (size_t i = start; i < end; i++) {
+        void *elem_addr = elem_at(array, i);
+        void *ptr_value = NULL;
+
+        if (array->_elem_size >= sizeof(void *)) {
+            memcpy(&ptr_value, elem_addr, sizeof(void *));
+        } else {
+            unsigned char tmp[sizeof(void *)];
+            memset(tmp, 0, sizeof(tmp));
+            memcpy(tmp, elem_addr, array->_elem_size);
+            memcpy(&ptr_value, tmp, sizeof(void *));
+        }
+
+        if (ptr_value)
+            free(ptr_value);
+    }
 }
 
 static void array_free(JARRAY *array) {
     if (!array) return;
 
     if (array->_data) {
-        if (array->_data_type == JARRAY_TYPE_POINTER && array->_length > 0) {
-            for (size_t i = 0; i < array->_length; i++) {
-                void *elem_addr = (char*)array->_data + i * array->_elem_size;
-                void *ptr_value = NULL;
-
-                if (array->_elem_size >= sizeof(void *)) {
-                    memcpy(&ptr_value, elem_addr, sizeof(void *));
-                } else {
-                    unsigned char tmp[sizeof(void *)];
-                    memset(tmp, 0, sizeof(tmp));
-                    memcpy(tmp, elem_addr, array->_elem_size);
-                    memcpy(&ptr_value, tmp, sizeof(void *));
-                }
-
-                if (ptr_value)
-                    free(ptr_value);
-            }
-        }
+        if (array->_data_type == JARRAY_TYPE_POINTER)
+            free_pointer_elems(array, 0, array->_length);
 
         free(array->_data);
         array->_data = NULL;
     }
+    hash_index_destroy(array);
+    bloom_destroy(array);
 
     array->_length = 0;
     array->_elem_size = 0;
@@ -115,21 +464,59 @@ static void array_free(JARRAY *array) {
 }
 
 
-static void create_return_error(const JARRAY* ret_source, JARRAY_ERROR error_code, const char* fmt, ...) {
-    va_list args;
-    va_start(args, fmt);
+static void vcreate_return_error(const JARRAY* ret_source, JARRAY_ERROR error_code, const char* fmt, va_list args) {
     last_error_trace.has_error = true;
     last_error_trace.error_code = error_code;
-    vsnprintf(last_error_trace.error_msg, MAX_ERR_MSG_LENGTH, fmt, args);
     last_error_trace.ret_source = ret_source;
+    // Messages without arguments are copied as is, only the others go through vsnprintf
+    if (strchr(fmt, '%')) {
+        vsnprintf(last_error_trace.error_msg, MAX_ERR_MSG_LENGTH, fmt, args);
+    } else {
+        size_t length = strnlen(fmt, MAX_ERR_MSG_LENGTH - 1);
+        memcpy(last_error_trace.error_msg, fmt, length);
+        last_error_trace.error_msg[length] = '\0';
+    }
+}
+
+static void create_return_error(const JARRAY* ret_source, JARRAY_ERROR error_code, const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    vcreate_return_error(ret_source, error_code, fmt, args);
     va_end(args);
 }
 
+/// Runs after every successful call: only plain stores, the "no error" text comes from error_message.
 static void reset_error_trace(){
     last_error_trace.has_error = false;
     last_error_trace.ret_source = NULL;
     last_error_trace.error_code = JARRAY_NO_ERROR;
-    snprintf(last_error_trace.error_msg, MAX_ERR_MSG_LENGTH, "no error");
+}
+
+void jarray_internal_error(const JARRAY *ret_source, JARRAY_ERROR error_code, const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    vcreate_return_error(ret_source, error_code, fmt, args);
+    va_end(args);
+}
+
+void jarray_internal_reset_error(void) {
+    reset_error_trace();
+}
+
+void jarray_internal_copy_elems(JARRAY *model, void *dest, const void *src, size_t count) {
+    memcpy_elem(model, dest, src, count);
+}
+
+void jarray_internal_refresh_attachments(JARRAY *self) {
+    if (self->_hash_index && !hash_index_ready(self)) hash_index_destroy(self);
+    if (self->_bloom_filter && self->_bloom_filter->stale && !bloom_rebuild(self)) bloom_destroy(self);
+}
+
+void jarray_internal_free_elems(const JARRAY *model, void *data, size_t count) {
+    if (model->_data_type != JARRAY_TYPE_POINTER) return;
+    JARRAY view = *model;
+    view._data = data;
+    free_pointer_elems(&view, 0, count);
 }
 
 static void init_array_callbacks(JARRAY *array){
@@ -145,6 +532,90 @@ static void init_array_overrides(JARRAY *array){
     array->user_overrides.print_error_override = NULL;
 }
 
+/**
+ * Returns the kind of vectorized scan usable for equality lookups in `self`,
+ * i.e. numeric presets still using the preset `is_equal_callback`.
+ */
+static JARRAY_SCAN_KIND scan_kind(const JARRAY *self) {
+    if (self->_data_type != JARRAY_TYPE_VALUE) return JARRAY_SCAN_NONE;
+
+    bool (*preset_is_equal)(const void*, const void*) = NULL;
+    switch (self->_type_preset) {
+        case JARRAY_FLOAT_PRESET:
+            return self->user_callbacks.is_equal_callback == jarray_internal_is_equal_float && self->_elem_size == sizeof(float)
+                       ? JARRAY_SCAN_FLOAT : JARRAY_SCAN_NONE;
+        case JARRAY_DOUBLE_PRESET:
+            return self->user_callbacks.is_equal_callback == jarray_internal_is_equal_double && self->_elem_size == sizeof(double)
+                       ? JARRAY_SCAN_DOUBLE : JARRAY_SCAN_NONE;
+        case JARRAY_INT_PRESET:    preset_is_equal = jarray_internal_is_equal_int;    break;
+        case JARRAY_CHAR_PRESET:   preset_is_equal = jarray_internal_is_equal_char;   break;
+        case JARRAY_LONG_PRESET:   preset_is_equal = jarray_internal_is_equal_long;   break;
+        case JARRAY_SHORT_PRESET:  preset_is_equal = jarray_internal_is_equal_short;  break;
+        case JARRAY_UINT_PRESET:   preset_is_equal = jarray_internal_is_equal_uint;   break;
+        case JARRAY_ULONG_PRESET:  preset_is_equal = jarray_internal_is_equal_ulong;  break;
+        case JARRAY_USHORT_PRESET: preset_is_equal = jarray_internal_is_equal_ushort; break;
+        default: return JARRAY_SCAN_NONE;
+    }
+    if (self->user_callbacks.is_equal_callback != preset_is_equal) return JARRAY_SCAN_NONE;
+
+    switch (self->_elem_size) {
+        case 1: return JARRAY_SCAN_INT8;
+        case 2: return JARRAY_SCAN_INT16;
+        case 4: return JARRAY_SCAN_INT32;
+        case 8: return JARRAY_SCAN_INT64;
+        default: return JARRAY_SCAN_NONE;
+    }
+}
+
+/**
+ * Calls `visitor` with the index of every element equal to `elem`, in ascending order, using the hash index,
+ * the vectorized scan or `is_equal_callback`, whichever applies. Stops as soon as `visitor` returns false.
+ * `is_equal_callback` must be set. Returns false if memory allocation failed.
+ */
+static bool scan_matches(JARRAY *self, const void *elem, bool (*visitor)(size_t index, void *ctx), void *ctx) {
+    if (!bloom_may_contain(self, elem)) return true;
+    if (hash_index_ready(self)) {
+        INDEX_BUFFER buffer = {0};
+        hash_index_lookup(self, elem, visit_buffer_index, &buffer);
+        if (buffer.failed) {
+            free(buffer.indexes);
+            return false;
+        }
+        if (buffer.count > 1)
+            qsort(buffer.indexes, buffer.count, sizeof(size_t), compare_callback_size_t);
+        for (size_t i = 0; i < buffer.count && visitor(buffer.indexes[i], ctx); i++);
+        free(buffer.indexes);
+        return true;
+    }
+
+    JARRAY_SCAN_KIND kind = scan_kind(self);
+    if (kind != JARRAY_SCAN_NONE) {
+        for (size_t i = jarray_scan_find(kind, self->_data, self->_length, 0, elem); i < self->_length;
+             i = jarray_scan_find(kind, self->_data, self->_length, i + 1, elem)) {
+            if (!visitor(i, ctx)) break;
+        }
+        return true;
+    }
+
+    for (size_t i = 0; i < self->_length; i++) {
+        if (self->user_callbacks.is_equal_callback(elem_at(self, i), elem) && !visitor(i, ctx))
+            break;
+    }
+    return true;
+}
+
+static bool visit_count(size_t index, void *ctx) {
+    (void)index;
+    (*(size_t*)ctx)++;
+    return true;
+}
+
+static bool visit_set_bit(size_t index, void *ctx) {
+    uint64_t *bitmap = ctx;
+    bitmap[index / 64] |= (uint64_t)1 << (index % 64);
+    return true;
+}
+
 static void* array_at(const JARRAY *self, size_t index) {
     if (!self){
         create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot find element in a NULL JARRAY");
@@ -195,6 +666,7 @@ static void array_add(JARRAY *self, const void *elem) {
 
     memcpy_elem(self, (char *)self->_data + self->_length * self->_elem_size, elem, 1);
     self->_length++;
+    track_insert(self, self->_length - 1);
     reset_error_trace();
 }
 
@@ -238,10 +710,12 @@ static void array_add_at(JARRAY *self, size_t index, const void *elem) {
             (char *)self->_data + index * self->_elem_size,
             (self->_length - index) * self->_elem_size
         );
+        hash_index_shift(self, index, 1);
     }
 
     memcpy_elem(self, (char *)self->_data + index * self->_elem_size, elem, 1);
     self->_length++;
+    track_insert(self, index);
     reset_error_trace();
 }
 
@@ -254,6 +728,8 @@ static void array_remove_at(JARRAY *self, size_t index) {
         return create_return_error(self, JARRAY_INDEX_OUT_OF_BOUND,
                                    "Index %zu out of bound for remove", index);
 
+    hash_index_erase(self, index);
+    hash_index_shift(self, index + 1, -1);
     size_t move_count = self->_length - index - 1;
     if (move_count > 0) {
         memmove(
@@ -309,6 +785,8 @@ static void array_init(JARRAY *array, size_t _elem_size, JARRAY_DATA_TYPE data_t
     array->_type_preset = JARRAY_NO_PRESET;
     init_array_callbacks(array);
     init_array_overrides(array);
+    array->_hash_index = NULL;
+    array->_bloom_filter = NULL;
     array->user_callbacks = imp;
     if (data_type == JARRAY_TYPE_POINTER && !array->user_callbacks.copy_elem_callback) return create_return_error(array, JARRAY_UNIMPLEMENTED_FUNCTION, "'copy_elem_callback' function must me implemented and referenced in 'user_overrides' struct in array");
     reset_error_trace();
@@ -335,6 +813,8 @@ static void array_init_with_data_copy(JARRAY *array, const void *data, size_t le
 
     init_array_callbacks(array);
     init_array_overrides(array);
+    array->_hash_index = NULL;
+    array->_bloom_filter = NULL;
     array->user_callbacks = imp;
     if (data_type == JARRAY_TYPE_POINTER && !array->user_callbacks.copy_elem_callback) return create_return_error(array, JARRAY_UNIMPLEMENTED_FUNCTION, "'copy_elem_callback' function must me implemented and referenced in 'user_overrides' struct in array");
     reset_error_trace();
@@ -357,11 +837,31 @@ static void array_init_with_data(JARRAY *array, void *data, size_t length, size_
 
     init_array_callbacks(array);
     init_array_overrides(array);
+    array->_hash_index = NULL;
+    array->_bloom_filter = NULL;
     array->user_callbacks = imp;
     if (data_type == JARRAY_TYPE_POINTER && !array->user_callbacks.copy_elem_callback) return create_return_error(array, JARRAY_UNIMPLEMENTED_FUNCTION, "'copy_elem_callback' function must me implemented and referenced in 'user_overrides' struct in array");
     reset_error_trace();
 }
 
+/// Empty array with the element type, callbacks and settings of `self`.
+static JARRAY empty_like(const JARRAY *self) {
+    JARRAY result;
+    result._length = 0;
+    result._min_alloc = 0;
+    result._capacity = 0;
+    result._capacity_multiplier = self->_capacity_multiplier;
+    result._elem_size = self->_elem_size;
+    result._data_type = self->_data_type;
+    result._type_preset = self->_type_preset;
+    result._data = NULL;
+    result.user_callbacks = self->user_callbacks;
+    result.user_overrides = self->user_overrides;
+    result._hash_index = NULL;
+    result._bloom_filter = NULL;
+    return result;
+}
+
 static JARRAY array_filter(JARRAY *self, bool (*predicate)(const void *elem, const void *ctx), const void *ctx) {
     if (!self){
         create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot find element in a NULL JARRAY");
@@ -372,31 +872,136 @@ static JARRAY array_filter(JARRAY *self, bool (*predicate)(const void *elem, con
         return *self;
     }
 
+    JARRAY result = empty_like(self);
+
+    // Single predicate pass recording the selection, so the result can be allocated with its exact size
+    uint64_t *selection = calloc(self->_length / 64 + 1, sizeof(uint64_t));
+    if (!selection) {
+        create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for filter selection");
+        return result;
+    }
     size_t count = 0;
     for (size_t i = 0; i < self->_length; i++) {
-        void *elem = (char*)self->_data + i * self->_elem_size;
-        if (predicate(elem, ctx)) count++;
+        if (predicate(elem_at(self, i), ctx)) {
+            selection[i / 64] |= (uint64_t)1 << (i % 64);
+            count++;
+        }
     }
 
-    JARRAY result;
+    if (count > 0) {
+        result._data = malloc(count * self->_elem_size);
+        if (!result._data) {
+            free(selection);
+            create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for filtered array");
+            return result;
+        }
+    }
+    size_t j = 0;
+    for (size_t w = 0; w <= self->_length / 64; w++) {
+        for (uint64_t bits = selection[w]; bits; bits &= bits - 1) {
+            size_t i = w * 64 + (size_t)__builtin_ctzll(bits);
+            memcpy_elem(self, elem_at(&result, j++), elem_at(self, i), 1);
+        }
+    }
+    free(selection);
     result._length = count;
     result._min_alloc = count;
     result._capacity = count;
-    result._capacity_multiplier = self->_capacity_multiplier;
-    result._elem_size = self->_elem_size;
-    result._data = malloc(count * self->_elem_size);
-    result.user_callbacks = self->user_callbacks;
-    result.user_overrides = self->user_overrides;
+    reset_error_trace();
+    return result;
+}
 
-    size_t j = 0;
+static void array_filter_into(JARRAY *self, JARRAY *dst, bool (*predicate)(const void *elem, const void *ctx), const void *ctx) {
+    if (!self || !dst)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot filter from or into a NULL JARRAY");
+    if (!predicate)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Predicate cannot be NULL");
+    if (dst->_elem_size != self->_elem_size)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Destination element size %zu differs from source element size %zu", dst->_elem_size, self->_elem_size);
+
+    if (dst == self) {
+        // In place: compact the kept elements to the front, the buffer is kept as is
+        size_t kept = 0;
+        for (size_t i = 0; i < self->_length; i++) {
+            if (predicate(elem_at(self, i), ctx)) {
+                if (kept != i) memcpy(elem_at(self, kept), elem_at(self, i), self->_elem_size);
+                kept++;
+            } else if (self->_data_type == JARRAY_TYPE_POINTER) {
+                free_pointer_elems(self, i, i + 1);
+            }
+        }
+        self->_length = kept;
+        hash_index_invalidate(self);
+        return reset_error_trace();
+    }
+
+    if (dst->_data_type == JARRAY_TYPE_POINTER)
+        free_pointer_elems(dst, 0, dst->_length);
+    dst->_length = 0;
     for (size_t i = 0; i < self->_length; i++) {
-        void *elem = (char*)self->_data + i * self->_elem_size;
-        if (predicate(elem, ctx)) {
-            memcpy_elem(self, (char*)result._data + j * self->_elem_size, elem, 1);
-            j++;
+        const void *elem = elem_at(self, i);
+        if (!predicate(elem, ctx)) continue;
+        if (dst->_length == dst->_capacity) {
+            // Only grows: once the buffer fits the typical selection, later calls do not allocate
+            size_t new_cap = (size_t)((float)dst->_capacity * dst->_capacity_multiplier);
+            if (new_cap <= dst->_capacity) new_cap = dst->_capacity + 8;
+            void *new_data = realloc(dst->_data, new_cap * dst->_elem_size);
+            if (!new_data) {
+                hash_index_invalidate(dst);
+                bloom_invalidate(dst);
+                return create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed in filter_into");
+            }
+            dst->_data = new_data;
+            dst->_capacity = new_cap;
         }
+        memcpy_elem(dst, elem_at(dst, dst->_length), elem, 1);
+        dst->_length++;
     }
+    hash_index_invalidate(dst);
+    bloom_invalidate(dst);
+    reset_error_trace();
+}
+
+/// Fills `result` (already initialized, empty) with `fn` applied to every element of `self`, written straight into the result slots.
+static void map_into(JARRAY *self, JARRAY *result, void (*fn)(const void *elem, void *out, void *ctx), void *ctx) {
+    if (self->_length == 0) return reset_error_trace();
+    jarray.reserve(result, self->_length);
+    if (last_error_trace.has_error)
+        return create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for map result");
+    for (size_t i = 0; i < self->_length; i++)
+        fn(elem_at(self, i), elem_at(result, i), ctx);
+    result->_length = self->_length;
     reset_error_trace();
+}
+
+static JARRAY array_map(JARRAY *self, size_t out_elem_size, JARRAY_DATA_TYPE out_type, JARRAY_USER_CALLBACK_IMPLEMENTATION out_callbacks, void (*fn)(const void *elem, void *out, void *ctx), void *ctx) {
+    JARRAY result;
+    jarray.init(&result, out_elem_size, out_type, out_callbacks);
+    if (last_error_trace.has_error) return result;
+    if (!self) {
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot map a NULL JARRAY");
+        return result;
+    }
+    if (!fn || out_elem_size == 0) {
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Map function cannot be NULL and output element size cannot be 0");
+        return result;
+    }
+    map_into(self, &result, fn, ctx);
+    return result;
+}
+
+static JARRAY array_map_preset(JARRAY *self, JARRAY_TYPE_PRESET preset, void (*fn)(const void *elem, void *out, void *ctx), void *ctx) {
+    JARRAY result = jarray.init_preset(preset);
+    if (last_error_trace.has_error) return result;
+    if (!self) {
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot map a NULL JARRAY");
+        return result;
+    }
+    if (!fn) {
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Map function cannot be NULL");
+        return result;
+    }
+    map_into(self, &result, fn, ctx);
     return result;
 }
 
@@ -499,6 +1104,7 @@ static void array_sort(JARRAY *self, SORT_METHOD method, int (*custom_compare_ca
     free(self->_data);
     self->_data = copy_data;
     self->_capacity = self->_length;
+    hash_index_invalidate(self);
     reset_error_trace();
 }
 
@@ -578,6 +1184,10 @@ static JARRAY array_subarray(JARRAY *self, size_t start, size_t end){
     ret_array._data = malloc(sub_length * self->_elem_size);
     ret_array.user_callbacks = self->user_callbacks;
     ret_array.user_overrides = self->user_overrides;
+    ret_array._hash_index = NULL;
+    ret_array._bloom_filter = NULL;
+    ret_array._data_type = self->_data_type;
+    ret_array._type_preset = self->_type_preset;
     if (!ret_array._data) {
         create_return_error(self, JARRAY_DATA_NULL, "Failed to allocate memory for subarray _data\n");
         return *self;
@@ -604,7 +1214,9 @@ static void array_set(JARRAY *self, size_t index, const void *elem) {
         return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Index cannot be higher or equal to the _length of array\n");
 
     // Copy the new element into the array at the given index
+    hash_index_erase(self, index);
     memcpy_elem(self, (char*)self->_data + index * self->_elem_size, elem, 1);
+    track_insert(self, index);
     reset_error_trace();
 }
 
@@ -621,26 +1233,112 @@ static size_t* array_indexes_of(JARRAY *self, const void *elem) {
         create_return_error(self, JARRAY_IS_EQUAL_CALLBACK_UNINTIALIZED, "is_equal_callback callback not set");
         return NULL;
     }
-    size_t *indexes = malloc(self->_length * sizeof(size_t));
-    if (!indexes) {
+    // Slot 0 is reserved for the count, the buffer only grows with the matches
+    INDEX_BUFFER buffer = {0};
+    visit_buffer_index(0, &buffer);
+    if (buffer.failed || !scan_matches(self, elem, visit_buffer_index, &buffer) || buffer.failed) {
+        free(buffer.indexes);
         create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for indexes array");
         return NULL;
     }
-    size_t count = 0;
-    for (size_t i = 0; i < self->_length; i++) {
-        if (self->user_callbacks.is_equal_callback((char*)self->_data + i * self->_elem_size, elem)) {
-            indexes[count+1] = i; // Store the index of the matching element
-            count++;
-        }
-    }
+    size_t count = buffer.count - 1;
     if (count == 0) {
-        free(indexes);
+        free(buffer.indexes);
         create_return_error(self, JARRAY_ELEMENT_NOT_FOUND, "No matching elements found");
         return NULL;
     }
-    indexes[0] = count; // Store the count of matches at the first index
+    buffer.indexes[0] = count; // Store the count of matches at the first index
+    reset_error_trace();
+    return buffer.indexes;
+}
+
+static bool check_match_args(JARRAY *self, const void *elem) {
+    if (!self) {
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot find element in a NULL JARRAY");
+        return false;
+    }
+    if (!elem) {
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot search a NULL element");
+        return false;
+    }
+    if (self->user_callbacks.is_equal_callback == NULL) {
+        create_return_error(self, JARRAY_IS_EQUAL_CALLBACK_UNINTIALIZED, "is_equal_callback callback not set");
+        return false;
+    }
+    return true;
+}
+
+static JARRAY array_indexes_of_jarray(JARRAY *self, const void *elem) {
+    JARRAY result = jarray.init_preset(JARRAY_ULONG_PRESET);
+    if (!check_match_args(self, elem)) return result;
+
+    INDEX_BUFFER buffer = {0};
+    if (!scan_matches(self, elem, visit_buffer_index, &buffer) || buffer.failed) {
+        free(buffer.indexes);
+        create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for indexes array");
+        return result;
+    }
+    if (buffer.count > 0) {
+        // Shrink to the exact number of matches and hand the buffer over to the result
+        size_t *indexes = realloc(buffer.indexes, buffer.count * sizeof(size_t));
+        if (indexes) buffer.indexes = indexes;
+        result._data = buffer.indexes;
+        result._length = buffer.count;
+        result._capacity = buffer.count;
+    }
+    reset_error_trace();
+    return result;
+}
+
+static uint64_t* array_matches_bitmap(JARRAY *self, const void *elem) {
+    if (!check_match_args(self, elem)) return NULL;
+
+    uint64_t *bitmap = calloc(self->_length / 64 + 1, sizeof(uint64_t));
+    if (!bitmap) {
+        create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for matches bitmap");
+        return NULL;
+    }
+    if (!scan_matches(self, elem, visit_set_bit, bitmap)) {
+        free(bitmap);
+        create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed while searching matches");
+        return NULL;
+    }
+    reset_error_trace();
+    return bitmap;
+}
+
+static size_t array_count_of(JARRAY *self, const void *elem) {
+    if (!check_match_args(self, elem)) return 0;
+
+    size_t count = 0;
+    if (!scan_matches(self, elem, visit_count, &count)) {
+        create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed while searching matches");
+        return 0;
+    }
+    reset_error_trace();
+    return count;
+}
+
+typedef struct MATCH_CALLBACK_CTX {
+    JARRAY *self;
+    bool (*callback)(size_t index, void *elem, void *ctx);
+    void *ctx;
+} MATCH_CALLBACK_CTX;
+
+static bool visit_user_callback(size_t index, void *ctx) {
+    MATCH_CALLBACK_CTX *match = ctx;
+    return match->callback(index, elem_at(match->self, index), match->ctx);
+}
+
+static void array_for_each_match(JARRAY *self, const void *elem, bool (*callback)(size_t index, void *elem, void *ctx), void *ctx) {
+    if (!check_match_args(self, elem)) return;
+    if (!callback)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Callback function is null");
+
+    MATCH_CALLBACK_CTX match = { self, callback, ctx };
+    if (!scan_matches(self, elem, visit_user_callback, &match))
+        return create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed while searching matches");
     reset_error_trace();
-    return indexes;
 }
 
 static void array_for_each(JARRAY *self, void (*callback)(void *elem, void *ctx), void *ctx) {
@@ -655,20 +1353,95 @@ static void array_for_each(JARRAY *self, void (*callback)(void *elem, void *ctx)
         void *elem = (char*)self->_data + i * self->_elem_size;
         callback(elem, ctx);
     }
+    hash_index_invalidate(self);
+    bloom_invalidate(self);
     reset_error_trace();
 }
 
-static void array_clear(JARRAY *self) {
+#define CHUNK_DEFAULT_SIZE 1024     // elements per block of the *_chunk functions when 0 is given
+
+static void array_for_each_chunk(JARRAY *self, size_t chunk_size, void (*callback)(void *chunk, size_t count, size_t start_index, void *ctx), void *ctx) {
     if (!self)
-        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot find element in a NULL JARRAY");
-    if (self->_data == NULL) 
-        return create_return_error(self, JARRAY_DATA_NULL, "Data field of array is null");
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot iterate over a NULL JARRAY");
+    if (!callback)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Callback function is null");
+    if (self->_length == 0)
+        return create_return_error(self, JARRAY_EMPTY, "Cannot iterate over an empty array");
+    if (chunk_size == 0) chunk_size = CHUNK_DEFAULT_SIZE;
+
+    for (size_t start = 0; start < self->_length; start += chunk_size) {
+        size_t count = self->_length - start < chunk_size ? self->_length - start : chunk_size;
+        callback(elem_at(self, start), count, start, ctx);
+    }
+    hash_index_invalidate(self);
+    bloom_invalidate(self);
+    reset_error_trace();
+}
+
+static bool array_any_chunk(const JARRAY *self, size_t chunk_size, bool (*predicate)(const void *chunk, size_t count, size_t start_index, const void *ctx), const void *ctx) {
+    if (!self) {
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot find element in a NULL JARRAY");
+        return false;
+    }
+    if (self->_length == 0) {
+        create_return_error(self, JARRAY_EMPTY, "Cannot check any on an empty array");
+        return false;
+    }
+    if (!predicate) {
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Predicate function is null");
+        return false;
+    }
+    if (chunk_size == 0) chunk_size = CHUNK_DEFAULT_SIZE;
+
+    reset_error_trace();
+    for (size_t start = 0; start < self->_length; start += chunk_size) {
+        size_t count = self->_length - start < chunk_size ? self->_length - start : chunk_size;
+        if (predicate(elem_at(self, start), count, start, ctx))
+            return true;
+    }
+    return false;
+}
+
+static void* array_find_first_chunk(JARRAY *self, size_t chunk_size, size_t (*finder)(const void *chunk, size_t count, size_t start_index, const void *ctx), const void *ctx) {
+    if (!self) {
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot find element in a NULL JARRAY");
+        return NULL;
+    }
+    if (!finder) {
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Finder cannot be NULL");
+        return NULL;
+    }
+    if (self->_length == 0) {
+        create_return_error(self, JARRAY_EMPTY, "Cannot find element in an empty array");
+        return NULL;
+    }
+    if (chunk_size == 0) chunk_size = CHUNK_DEFAULT_SIZE;
+
+    for (size_t start = 0; start < self->_length; start += chunk_size) {
+        size_t count = self->_length - start < chunk_size ? self->_length - start : chunk_size;
+        size_t offset = finder(elem_at(self, start), count, start, ctx);
+        if (offset < count) {
+            reset_error_trace();
+            return elem_at(self, start + offset);
+        }
+    }
+    create_return_error(self, JARRAY_ELEMENT_NOT_FOUND, "Found no element corrsponding with finder conditions");
+    return NULL;
+}
+
+static void array_clear(JARRAY *self) {
+    if (!self)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot find element in a NULL JARRAY");
+    if (self->_data == NULL) 
+        return create_return_error(self, JARRAY_DATA_NULL, "Data field of array is null");
     // Free existing _data
     if (self->_min_alloc == 0){
         free(self->_data);
         self->_data = NULL;
     }
     self->_length = 0;
+    hash_index_reset(self);
+    bloom_reset(self);
     jarray.reserve(self, self->_min_alloc);
     reset_error_trace();
 }
@@ -688,6 +1461,7 @@ static JARRAY array_clone(JARRAY *self) {
     clone._min_alloc = self->_min_alloc;
     clone._elem_size = self->_elem_size;
     clone._data_type = self->_data_type;
+    clone._type_preset = self->_type_preset;
     clone._capacity = self->_capacity;
     clone._capacity_multiplier = self->_capacity_multiplier;
     clone._data = malloc(self->_capacity * self->_elem_size);
@@ -699,6 +1473,8 @@ static JARRAY array_clone(JARRAY *self) {
     memcpy_elem(self, clone._data, self->_data, max_size_t(self->_length, self->_min_alloc));
     clone.user_callbacks = self->user_callbacks;
     clone.user_overrides = self->user_overrides;
+    clone._hash_index = NULL;
+    clone._bloom_filter = NULL;
 
     reset_error_trace();
     return clone;
@@ -739,6 +1515,8 @@ static void array_add_all(JARRAY *self, const void *data, size_t count) {
                 (char *)self->_data + self->_length * self->_elem_size,
                 data, count);
     self->_length += count;
+    for (size_t i = self->_length - count; i < self->_length; i++)
+        track_insert(self, i);
     reset_error_trace();
 }
 
@@ -763,6 +1541,16 @@ static bool array_contains(JARRAY *self, const void *elem) {
 
     reset_error_trace();
 
+    if (!bloom_may_contain(self, elem)) return false;
+    if (hash_index_ready(self)) {
+        bool found = false;
+        hash_index_lookup(self, elem, visit_any_index, &found);
+        return found;
+    }
+    JARRAY_SCAN_KIND kind = scan_kind(self);
+    if (kind != JARRAY_SCAN_NONE)
+        return jarray_scan_find(kind, self->_data, self->_length, 0, elem) < self->_length;
+
     for (size_t i = 0; i < self->_length; i++) {
         void *current_elem = (char*)self->_data + i * self->_elem_size;
         if (self->user_callbacks.is_equal_callback(current_elem, elem)) {
@@ -773,12 +1561,6 @@ static bool array_contains(JARRAY *self, const void *elem) {
     return false;
 }
 
-static int compare_callback_size_t(const void *a, const void *b) {
-    size_t val_a = *(const size_t*)a;
-    size_t val_b = *(const size_t*)b;
-    return (val_a > val_b) - (val_a < val_b);
-}
-
 static void array_remove_all(JARRAY *self, const void *data, size_t count) {
     if (!self)
         return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot find element in a NULL JARRAY");
@@ -915,11 +1697,85 @@ static JARRAY array_concat(JARRAY *arr1, JARRAY *arr2) {
     memcpy_elem(arr2, (char*)new_array._data + arr1->_length * arr1->_elem_size, arr2->_data, arr2->_length);
     new_array.user_callbacks = arr1->user_callbacks;
     new_array.user_overrides = arr1->user_overrides;
+    new_array._hash_index = NULL;
+    new_array._bloom_filter = NULL;
+    new_array._data_type = arr1->_data_type;
+    new_array._type_preset = arr1->_type_preset;
 
     reset_error_trace();
     return new_array;
 }
 
+#define STRING_BUILDER_MIN_CAPACITY 64
+#define ELEMENT_FORMAT_RESERVE 32
+#define WRITE_TO_BUFFER_SIZE 65536
+#define PRINT_BUFFER_SIZE 65536
+
+/// Growable character buffer with tracked length, so appending never rescans what was already written.
+typedef struct STRING_BUILDER {
+    char *data;
+    size_t length;
+    size_t capacity;
+} STRING_BUILDER;
+
+/// Makes room for `extra` more characters plus the terminator, doubling the capacity.
+static bool builder_reserve(STRING_BUILDER *builder, size_t extra) {
+    if (builder->capacity - builder->length > extra) return true;
+    size_t needed = builder->length + extra + 1;
+    size_t capacity = builder->capacity ? builder->capacity : STRING_BUILDER_MIN_CAPACITY;
+    while (capacity < needed) capacity *= 2;
+    char *data = realloc(builder->data, capacity);
+    if (!data) return false;
+    builder->data = data;
+    builder->capacity = capacity;
+    return true;
+}
+
+static bool builder_append(STRING_BUILDER *builder, const char *str, size_t length) {
+    if (!builder_reserve(builder, length)) return false;
+    memcpy(builder->data + builder->length, str, length);
+    builder->length += length;
+    return true;
+}
+
+/// Appends the text of one element. Formats in place when `element_format_callback` is set, else copies (and frees) the `element_to_string_callback` result.
+static bool builder_append_elem(STRING_BUILDER *builder, const JARRAY *self, const void *elem) {
+    size_t (*format)(const void*, char*, size_t) = self->user_callbacks.element_format_callback;
+    if (format) {
+        if (!builder_reserve(builder, ELEMENT_FORMAT_RESERVE)) {
+            create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for result string");
+            return false;
+        }
+        size_t available = builder->capacity - builder->length;
+        size_t written = format(elem, builder->data + builder->length, available);
+        if (written >= available) {
+            if (!builder_reserve(builder, written)) {
+                create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for result string");
+                return false;
+            }
+            written = format(elem, builder->data + builder->length, written + 1);
+        }
+        builder->length += written;
+        return true;
+    }
+
+    char *str = self->user_callbacks.element_to_string_callback(elem);
+    if (!str) {
+        create_return_error(self, JARRAY_DATA_NULL, "element_to_string_callback callback returned null");
+        return false;
+    }
+    bool appended = builder_append(builder, str, strlen(str));
+    free(str);
+    if (!appended) create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for result string");
+    return appended;
+}
+
+static bool check_string_callbacks(const JARRAY *self) {
+    if (self->user_callbacks.element_format_callback || self->user_callbacks.element_to_string_callback) return true;
+    create_return_error(self, JARRAY_ELEMENT_TO_STRING_CALLBACK_UNINTIALIZED, "element_to_string_callback callback not set");
+    return false;
+}
+
 static char* array_join(JARRAY *self, const char *separator) {
     if (!self) {
         create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot find element in a NULL JARRAY");
@@ -929,53 +1785,148 @@ static char* array_join(JARRAY *self, const char *separator) {
         create_return_error(self, JARRAY_EMPTY, "Cannot join elements of an empty array");
         return NULL;
     }
-    if (self->user_callbacks.element_to_string_callback == NULL) {
-        create_return_error(self, JARRAY_ELEMENT_TO_STRING_CALLBACK_UNINTIALIZED, "element_to_string_callback callback not set");
-        return NULL;
-    }
+    if (!check_string_callbacks(self)) return NULL;
 
-    size_t total_length = 0;
-    char **string_representations = malloc(self->_length * sizeof(char*));
-    if (!string_representations) {
-        create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for string representations");
+    if (!separator) separator = "";
+    size_t separator_length = strlen(separator);
+    STRING_BUILDER builder = {0};
+    // Room for the separators and a few characters per element up front, most joins never grow
+    if (!builder_reserve(&builder, separator_length * (self->_length - 1) + self->_length * 4)) {
+        create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for result string");
         return NULL;
     }
 
     for (size_t i = 0; i < self->_length; i++) {
-        void *elem = (char*)self->_data + i * self->_elem_size;
-        char *str = self->user_callbacks.element_to_string_callback(elem);
-        if (!str) {
-            for (size_t j = 0; j < i; j++) free(string_representations[j]);
-            free(string_representations);
-            create_return_error(self, JARRAY_DATA_NULL, "element_to_string_callback callback returned null");
+        if (i > 0 && !builder_append(&builder, separator, separator_length)) {
+            free(builder.data);
+            create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for result string");
+            return NULL;
+        }
+        if (!builder_append_elem(&builder, self, elem_at(self, i))) {
+            free(builder.data);
             return NULL;
         }
-        string_representations[i] = str;
-        total_length += strlen(str);
     }
+    builder.data[builder.length] = '\0';
+
+    reset_error_trace();
+    return builder.data;
+}
+
+/// Hands the buffered text to the writer and empties the buffer.
+static bool builder_flush(STRING_BUILDER *builder, const JARRAY *self, size_t (*writer)(const char*, size_t, void*), void *ctx) {
+    if (builder->length == 0) return true;
+    size_t accepted = writer(builder->data, builder->length, ctx);
+    if (accepted != builder->length) {
+        create_return_error(self, JARRAY_WRITE_FAILED, "Writer accepted %zu of %zu bytes", accepted, builder->length);
+        return false;
+    }
+    builder->length = 0;
+    return true;
+}
+
+static void array_write_to(JARRAY *self, const char *separator, size_t (*writer)(const char *data, size_t size, void *ctx), void *ctx) {
+    if (!self)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot write a NULL JARRAY");
+    if (!writer)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Writer function is NULL");
+    if (self->_length == 0) return reset_error_trace();
+    if (!check_string_callbacks(self)) return;
 
     if (!separator) separator = "";
     size_t separator_length = strlen(separator);
-    total_length += separator_length * (self->_length - 1) + 1; // for separators and null terminator
+    STRING_BUILDER builder = {0};
+    if (!builder_reserve(&builder, WRITE_TO_BUFFER_SIZE))
+        return create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for write buffer");
 
-    char *result = malloc(total_length);
-    if (!result) {
-        for (size_t i = 0; i < self->_length; i++) free(string_representations[i]);
-        free(string_representations);
-        create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for result string");
-        return NULL;
+    for (size_t i = 0; i < self->_length; i++) {
+        if (i > 0 && !builder_append(&builder, separator, separator_length)) {
+            free(builder.data);
+            return create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for write buffer");
+        }
+        if (!builder_append_elem(&builder, self, elem_at(self, i))) {
+            free(builder.data);
+            return;
+        }
+        if (builder.length >= WRITE_TO_BUFFER_SIZE && !builder_flush(&builder, self, writer, ctx)) {
+            free(builder.data);
+            return;
+        }
+    }
+    bool flushed = builder_flush(&builder, self, writer, ctx);
+    free(builder.data);
+    if (flushed) reset_error_trace();
+}
+
+static size_t write_to_stream(const char *data, size_t size, void *ctx) {
+    return fwrite(data, 1, size, (FILE*)ctx);
+}
+
+static size_t write_to_fd(const char *data, size_t size, void *ctx) {
+    int fd = *(const int*)ctx;
+    size_t written = 0;
+    while (written < size) {
+        ssize_t count = write(fd, data + written, size - written);
+        if (count < 0 && errno == EINTR) continue;
+        if (count <= 0) break;
+        written += (size_t)count;
     }
+    return written;
+}
+
+/// Text of array_print built in a fixed buffer handed to `writer`: numeric presets skip printf, other arrays go through their string callbacks.
+static void print_buffered(const JARRAY *self, size_t (*writer)(const char*, size_t, void*), void *ctx) {
+    bool fast = jarray_format_supported(self->_type_preset);
+    if (!fast && !check_string_callbacks(self)) return;
+
+    STRING_BUILDER builder = {0};
+    // A formatted value and its space always fit once the buffer is below PRINT_BUFFER_SIZE
+    if (!builder_reserve(&builder, PRINT_BUFFER_SIZE + JARRAY_FORMAT_MAX + 1))
+        return create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for print buffer");
+
+    char header[256];
+    int header_length = snprintf(header, sizeof(header), "JARRAY [size: %zu, capacity: %zu, min_alloc: %zu, capacity multiplier: %.2f] =>\n", self->_length, self->_capacity, self->_min_alloc, self->_capacity_multiplier);
+    builder_append(&builder, header, header_length < (int)sizeof(header) ? (size_t)header_length : sizeof(header) - 1);
 
-    result[0] = '\0';
     for (size_t i = 0; i < self->_length; i++) {
-        strcat(result, string_representations[i]);
-        if (i < self->_length - 1) strcat(result, separator);
-        free(string_representations[i]);
+        if (fast) {
+            builder.length += jarray_format_value(self->_type_preset, elem_at(self, i), builder.data + builder.length);
+            builder.data[builder.length++] = ' ';
+        } else {
+            if (!builder_append_elem(&builder, self, elem_at(self, i))) {
+                free(builder.data);
+                return;
+            }
+            if (!builder_append(&builder, " ", 1)) {
+                free(builder.data);
+                return create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for print buffer");
+            }
+        }
+        if (builder.length >= PRINT_BUFFER_SIZE && !builder_flush(&builder, self, writer, ctx)) {
+            free(builder.data);
+            return;
+        }
     }
-    free(string_representations);
+    builder.data[builder.length++] = '\n';
+    bool flushed = builder_flush(&builder, self, writer, ctx);
+    free(builder.data);
+    if (flushed) reset_error_trace();
+}
 
-    reset_error_trace();
-    return result;
+static void array_print_to(const JARRAY *self, FILE *stream) {
+    if (!self)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot print a NULL JARRAY");
+    if (!stream)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Stream is NULL");
+    print_buffered(self, write_to_stream, stream);
+}
+
+static void array_print_fd(const JARRAY *self, int fd) {
+    if (!self)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot print a NULL JARRAY");
+    if (fd < 0)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Invalid file descriptor %d", fd);
+    print_buffered(self, write_to_fd, &fd);
 }
 
 static void array_reverse(JARRAY *self) {
@@ -996,6 +1947,7 @@ static void array_reverse(JARRAY *self) {
         memcpy_elem(self, b, temp, 1);
     }
     free(temp);
+    hash_index_invalidate(self);
     reset_error_trace();
 }
 
@@ -1068,6 +2020,19 @@ static void* array_reduce_right(JARRAY *self, void *(*reducer)(const void *accum
     return accumulator;
 }
 
+static void array_fold(JARRAY *self, void *acc, void (*fn)(void *acc, const void *elem, void *ctx), void *ctx) {
+    if (!self)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot fold a NULL JARRAY");
+    if (!acc)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Accumulator cannot be NULL");
+    if (!fn)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Fold function is null");
+
+    for (size_t i = 0; i < self->_length; i++)
+        fn(acc, elem_at(self, i), ctx);
+    reset_error_trace();
+}
+
 static void* array_find_last(JARRAY *self, bool (*predicate)(const void *elem, const void *ctx), const void *ctx){
     if (!self) {
         create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot find element in a NULL JARRAY");
@@ -1158,6 +2123,9 @@ static void array_fill(JARRAY *self, const void *elem, size_t start, size_t end)
         return create_return_error(self, JARRAY_INVALID_ARGUMENT,
                                    "Cannot insert NULL in a jarray");
 
+    // Slots past the current length hold no element yet, the index cannot track them one by one
+    hash_index_invalidate(self);
+
     if (end >= self->_length) {
         size_t new_length = end + 1;
 
@@ -1204,6 +2172,8 @@ static void array_shift(JARRAY *self) {
         return create_return_error(self, JARRAY_INVALID_ARGUMENT,
                                    "Cannot shift an empty array");
 
+    hash_index_erase(self, 0);
+    hash_index_shift(self, 1, -1);
     memmove((char *)self->_data,
             (char *)self->_data + self->_elem_size,
             (self->_length - 1) * self->_elem_size);
@@ -1258,10 +2228,13 @@ static void array_shift_right(JARRAY *self, const void *elem) {
         memmove((char *)self->_data + self->_elem_size,
                 (char *)self->_data,
                 self->_length * self->_elem_size);
+        hash_index_shift(self, 0, 1);
     }
 
+    memcpy_elem(self, self->_data, elem, 1);
     self->_length++;
-    return array_set(self, 0, elem);
+    track_insert(self, 0);
+    reset_error_trace();
 }
 
 
@@ -1365,6 +2338,1741 @@ static void array_init_reserve(JARRAY *self, size_t elem_size, size_t capacity,
     jarray.reserve(self, capacity);
 }
 
+static void array_attach_hash_index(JARRAY *self) {
+    if (!self)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot attach a hash index to a NULL JARRAY");
+    if (!self->user_callbacks.hash_callback)
+        return create_return_error(self, JARRAY_HASH_CALLBACK_UNINTIALIZED, "hash_callback callback must be set to attach a hash index");
+    if (!self->user_callbacks.is_equal_callback)
+        return create_return_error(self, JARRAY_IS_EQUAL_CALLBACK_UNINTIALIZED, "is_equal_callback callback must be set to attach a hash index");
+
+    if (!self->_hash_index) {
+        self->_hash_index = calloc(1, sizeof(JARRAY_HASH_INDEX));
+        if (!self->_hash_index)
+            return create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for hash index");
+    }
+    if (!hash_index_rebuild(self)) {
+        hash_index_destroy(self);
+        return create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for hash index slots");
+    }
+    reset_error_trace();
+}
+
+static void array_detach_hash_index(JARRAY *self) {
+    if (!self)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot detach a hash index from a NULL JARRAY");
+    hash_index_destroy(self);
+    reset_error_trace();
+}
+
+/* ----- BATCH LOOKUPS ----- */
+
+#define FIND_MANY_SCAN_LIMIT 8      // below this many probes, one vectorized scan per probe beats building a table
+
+/// Index of the first element equal to `elem`, or `_length`. Callbacks must have been checked by the caller.
+static size_t first_match(JARRAY *self, const void *elem) {
+    size_t found = self->_length;
+    if (!bloom_may_contain(self, elem))
+        return found;
+    if (hash_index_ready(self)) {
+        hash_index_lookup(self, elem, visit_min_index, &found);
+    } else if (scan_kind(self) != JARRAY_SCAN_NONE) {
+        found = jarray_scan_find(scan_kind(self), self->_data, self->_length, 0, elem);
+    } else {
+        for (size_t i = 0; i < self->_length; i++) {
+            if (self->user_callbacks.is_equal_callback(elem_at(self, i), elem))
+                return i;
+        }
+    }
+    return found;
+}
+
+/// Hash table over the probes, then a single pass over the array resolving every probe hit by an element.
+static bool find_many_hash_probes(JARRAY *self, const char *probes, size_t count, size_t *first) {
+    JARRAY_HASH_INDEX table = {0};
+    size_t capacity = HASH_INDEX_MIN_CAPACITY;
+    while (capacity * 3 < count * 4)
+        capacity *= 2;
+    if (!hash_index_alloc(&table, capacity)) return false;
+    for (size_t k = 0; k < count; k++)
+        hash_index_place(&table, self->user_callbacks.hash_callback(probes + k * self->_elem_size), k + 1);
+
+    size_t mask = table.capacity - 1;
+    size_t remaining = count;
+    for (size_t i = 0; i < self->_length && remaining > 0; i++) {
+        const void *elem = elem_at(self, i);
+        size_t hash = self->user_callbacks.hash_callback(elem);
+        for (size_t pos = hash & mask; table.slots[pos] != 0; pos = (pos + 1) & mask) {
+            size_t k = table.slots[pos] - 1;
+            if (table.hashes[pos] != hash || first[k] != self->_length) continue;
+            if (self->user_callbacks.is_equal_callback(elem, probes + k * self->_elem_size)) {
+                first[k] = i;
+                remaining--;
+            }
+        }
+    }
+    free(table.slots);
+    free(table.hashes);
+    return true;
+}
+
+/// Hash table over the array (fewer elements than probes), then one lookup per probe.
+static bool find_many_hash_self(JARRAY *self, const char *probes, size_t count, size_t *first) {
+    JARRAY_HASH_INDEX table = {0};
+    size_t capacity = HASH_INDEX_MIN_CAPACITY;
+    while (capacity * 3 < self->_length * 4)
+        capacity *= 2;
+    if (!hash_index_alloc(&table, capacity)) return false;
+    for (size_t i = 0; i < self->_length; i++)
+        hash_index_place(&table, self->user_callbacks.hash_callback(elem_at(self, i)), i + 1);
+
+    size_t mask = table.capacity - 1;
+    for (size_t k = 0; k < count; k++) {
+        const void *probe = probes + k * self->_elem_size;
+        size_t hash = self->user_callbacks.hash_callback(probe);
+        for (size_t pos = hash & mask; table.slots[pos] != 0; pos = (pos + 1) & mask) {
+            size_t i = table.slots[pos] - 1;
+            if (table.hashes[pos] == hash && i < first[k] && self->user_callbacks.is_equal_callback(elem_at(self, i), probe))
+                first[k] = i;
+        }
+    }
+    free(table.slots);
+    free(table.hashes);
+    return true;
+}
+
+/// Stable merge sort of the probe indexes `order[0..count)` by the probes they reference.
+static void sort_probe_order(JARRAY *self, const char *probes, size_t *order, size_t *tmp, size_t count) {
+    if (count < 2) return;
+    size_t half = count / 2;
+    sort_probe_order(self, probes, order, tmp, half);
+    sort_probe_order(self, probes, order + half, tmp, count - half);
+
+    size_t a = 0, b = half, out = 0;
+    while (a < half && b < count) {
+        const void *pa = probes + order[a] * self->_elem_size;
+        const void *pb = probes + order[b] * self->_elem_size;
+        tmp[out++] = self->user_callbacks.compare_callback(pb, pa) < 0 ? order[b++] : order[a++];
+    }
+    while (a < half) tmp[out++] = order[a++];
+    while (b < count) tmp[out++] = order[b++];
+    memcpy(order, tmp, count * sizeof(size_t));
+}
+
+/// Sorts the probes with `compare_callback`, then a single pass over the array binary searching each element among them.
+static bool find_many_sorted(JARRAY *self, const char *probes, size_t count, size_t *first) {
+    size_t *order = malloc(count * sizeof(size_t));
+    size_t *tmp = malloc(count * sizeof(size_t));
+    if (!order || !tmp) {
+        free(order);
+        free(tmp);
+        return false;
+    }
+    for (size_t k = 0; k < count; k++)
+        order[k] = k;
+    sort_probe_order(self, probes, order, tmp, count);
+    free(tmp);
+
+    size_t remaining = count;
+    for (size_t i = 0; i < self->_length && remaining > 0; i++) {
+        const void *elem = elem_at(self, i);
+        size_t lo = 0, hi = count;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (self->user_callbacks.compare_callback(probes + order[mid] * self->_elem_size, elem) < 0) lo = mid + 1;
+            else hi = mid;
+        }
+        // Every probe of the equal range matches the element
+        for (; lo < count; lo++) {
+            const void *probe = probes + order[lo] * self->_elem_size;
+            if (self->user_callbacks.compare_callback(probe, elem) != 0) break;
+            if (first[order[lo]] == self->_length && self->user_callbacks.is_equal_callback(elem, probe)) {
+                first[order[lo]] = i;
+                remaining--;
+            }
+        }
+    }
+    free(order);
+    return true;
+}
+
+/**
+ * Fills `first[k]` with the index of the first element equal to probe `k` (`_length` if absent).
+ * Picks the strategy from the available callbacks and the sizes of both sides.
+ */
+static bool find_many(JARRAY *self, const void *probes, size_t count, size_t *first) {
+    for (size_t k = 0; k < count; k++)
+        first[k] = self->_length;
+    if (self->_length == 0 || count == 0) return true;
+
+    bool has_hash = self->user_callbacks.hash_callback != NULL;
+    bool has_compare = self->user_callbacks.compare_callback != NULL;
+    if (count <= FIND_MANY_SCAN_LIMIT || hash_index_ready(self) || (!has_hash && !has_compare)) {
+        for (size_t k = 0; k < count; k++)
+            first[k] = first_match(self, (const char*)probes + k * self->_elem_size);
+        return true;
+    }
+    if (has_hash)
+        return count <= self->_length ? find_many_hash_probes(self, probes, count, first)
+                                      : find_many_hash_self(self, probes, count, first);
+    return find_many_sorted(self, probes, count, first);
+}
+
+static bool check_many_args(JARRAY *self, const void *probes, size_t count, const void *out) {
+    if (!self) {
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot search elements in a NULL JARRAY");
+        return false;
+    }
+    if ((!probes && count > 0) || !out) {
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Probes and output buffer must not be NULL");
+        return false;
+    }
+    if (self->user_callbacks.is_equal_callback == NULL) {
+        create_return_error(self, JARRAY_IS_EQUAL_CALLBACK_UNINTIALIZED, "is_equal_callback callback not set");
+        return false;
+    }
+    return true;
+}
+
+static void array_index_of_many(JARRAY *self, const void *probes, size_t count, size_t *out_indexes) {
+    if (!check_many_args(self, probes, count, out_indexes)) return;
+    if (!find_many(self, probes, count, out_indexes))
+        return create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for batch lookup");
+    reset_error_trace();
+}
+
+static void array_contains_many(JARRAY *self, const void *probes, size_t count, uint64_t *out_bitmap) {
+    if (!check_many_args(self, probes, count, out_bitmap)) return;
+    size_t *first = malloc(max_size_t(count, 1) * sizeof(size_t));
+    if (!first)
+        return create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for batch lookup");
+    if (!find_many(self, probes, count, first)) {
+        free(first);
+        return create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for batch lookup");
+    }
+    memset(out_bitmap, 0, (count / 64 + 1) * sizeof(uint64_t));
+    for (size_t k = 0; k < count; k++) {
+        if (first[k] != self->_length)
+            out_bitmap[k / 64] |= (uint64_t)1 << (k % 64);
+    }
+    free(first);
+    reset_error_trace();
+}
+
+static size_t array_index_of(JARRAY *self, const void *elem) {
+    if (!self) {
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot find element in a NULL JARRAY");
+        return 0;
+    }
+    if (!elem) {
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot search a NULL element");
+        return self->_length;
+    }
+    if (self->user_callbacks.is_equal_callback == NULL) {
+        create_return_error(self, JARRAY_IS_EQUAL_CALLBACK_UNINTIALIZED, "is_equal_callback callback not set");
+        return self->_length;
+    }
+
+    size_t found = first_match(self, elem);
+    if (found == self->_length) {
+        create_return_error(self, JARRAY_ELEMENT_NOT_FOUND, "No matching element found");
+        return found;
+    }
+    reset_error_trace();
+    return found;
+}
+
+static void array_attach_bloom_filter(JARRAY *self, size_t bits_per_elem) {
+    if (!self)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot attach a bloom filter to a NULL JARRAY");
+    if (!self->user_callbacks.hash_callback)
+        return create_return_error(self, JARRAY_HASH_CALLBACK_UNINTIALIZED, "hash_callback callback must be set to attach a bloom filter");
+
+    if (!self->_bloom_filter) {
+        self->_bloom_filter = calloc(1, sizeof(JARRAY_BLOOM_FILTER));
+        if (!self->_bloom_filter)
+            return create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for bloom filter");
+    }
+    self->_bloom_filter->bits_per_elem = bits_per_elem ? bits_per_elem : BLOOM_DEFAULT_BITS_PER_ELEM;
+    if (!bloom_rebuild(self)) {
+        bloom_destroy(self);
+        return create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for bloom filter blocks");
+    }
+    reset_error_trace();
+}
+
+static void array_rebuild_bloom_filter(JARRAY *self) {
+    if (!self)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot rebuild the bloom filter of a NULL JARRAY");
+    if (!self->_bloom_filter)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "No bloom filter attached to the array");
+    if (!bloom_rebuild(self))
+        return create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed when rebuilding bloom filter");
+    reset_error_trace();
+}
+
+static void array_detach_bloom_filter(JARRAY *self) {
+    if (!self)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot detach a bloom filter from a NULL JARRAY");
+    bloom_destroy(self);
+    reset_error_trace();
+}
+
+/* ----- NUMERIC ----- */
+
+/// Checks that self is a non-NULL array of a numeric preset. Returns false after setting the error otherwise.
+static bool check_numeric(JARRAY *self, const char *action) {
+    if (!self) {
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot %s a NULL JARRAY", action);
+        return false;
+    }
+    if (self->_data_type != JARRAY_TYPE_VALUE || !jarray_numeric_supported(self->_type_preset)) {
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot %s an array that is not of a numeric preset", action);
+        return false;
+    }
+    return true;
+}
+
+/// Checks that other can be combined element-wise with self (already checked numeric).
+static bool check_numeric_pair(JARRAY *self, const JARRAY *other, const char *action) {
+    if (!other || other->_type_preset != self->_type_preset || other->_data_type != self->_data_type) {
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot %s arrays of different presets", action);
+        return false;
+    }
+    if (other->_length != self->_length) {
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot %s arrays of different lengths", action);
+        return false;
+    }
+    return true;
+}
+
+static void numeric_modified(JARRAY *self) {
+    hash_index_invalidate(self);
+    bloom_invalidate(self);
+}
+
+static void array_sum(JARRAY *self, void *out) {
+    if (!check_numeric(self, "sum")) return;
+    if (!out)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Output pointer cannot be NULL");
+    jarray_numeric_sum(self->_type_preset, self->_data, self->_length, out);
+    reset_error_trace();
+}
+
+static double array_mean(JARRAY *self) {
+    if (!check_numeric(self, "average")) return 0.0;
+    if (self->_length == 0) {
+        create_return_error(self, JARRAY_EMPTY, "Cannot average an empty array");
+        return 0.0;
+    }
+    double mean = jarray_numeric_mean(self->_type_preset, self->_data, self->_length);
+    reset_error_trace();
+    return mean;
+}
+
+static size_t numeric_arg_extremum(JARRAY *self, bool max) {
+    if (!check_numeric(self, max ? "find the maximum of" : "find the minimum of")) return 0;
+    if (self->_length == 0) {
+        create_return_error(self, JARRAY_EMPTY, "Cannot find the extremum of an empty array");
+        return 0;
+    }
+    size_t index = jarray_numeric_arg_extremum(self->_type_preset, self->_data, self->_length, max);
+    reset_error_trace();
+    return index;
+}
+
+static size_t array_argmin(JARRAY *self) {
+    return numeric_arg_extremum(self, false);
+}
+
+static size_t array_argmax(JARRAY *self) {
+    return numeric_arg_extremum(self, true);
+}
+
+static void* array_min(JARRAY *self) {
+    size_t index = numeric_arg_extremum(self, false);
+    if (last_error_trace.has_error) return NULL;
+    return elem_at(self, index);
+}
+
+static void* array_max(JARRAY *self) {
+    size_t index = numeric_arg_extremum(self, true);
+    if (last_error_trace.has_error) return NULL;
+    return elem_at(self, index);
+}
+
+static void array_dot(JARRAY *self, const JARRAY *other, void *out) {
+    if (!check_numeric(self, "compute the dot product of") || !check_numeric_pair(self, other, "compute the dot product of")) return;
+    if (!out)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Output pointer cannot be NULL");
+    jarray_numeric_dot(self->_type_preset, self->_data, other->_data, self->_length, out);
+    reset_error_trace();
+}
+
+static void array_scale(JARRAY *self, const void *factor) {
+    if (!check_numeric(self, "scale")) return;
+    if (!factor)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Scale factor cannot be NULL");
+    jarray_numeric_scale(self->_type_preset, self->_data, self->_length, factor);
+    numeric_modified(self);
+    reset_error_trace();
+}
+
+static void array_axpy(JARRAY *self, const void *alpha, const JARRAY *other) {
+    if (!check_numeric(self, "add to") || !check_numeric_pair(self, other, "add")) return;
+    if (!alpha)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Alpha cannot be NULL");
+    jarray_numeric_axpy(self->_type_preset, self->_data, other->_data, self->_length, alpha);
+    numeric_modified(self);
+    reset_error_trace();
+}
+
+static void numeric_binary(JARRAY *self, const JARRAY *other, JARRAY_NUMERIC_OP op, const char *action) {
+    if (!check_numeric(self, action) || !check_numeric_pair(self, other, action)) return;
+    jarray_numeric_binary(self->_type_preset, op, self->_data, other->_data, self->_length);
+    numeric_modified(self);
+    reset_error_trace();
+}
+
+static void array_add_array(JARRAY *self, const JARRAY *other) {
+    numeric_binary(self, other, JARRAY_NUMERIC_ADD, "add");
+}
+
+static void array_sub_array(JARRAY *self, const JARRAY *other) {
+    numeric_binary(self, other, JARRAY_NUMERIC_SUB, "subtract");
+}
+
+static void array_mul_array(JARRAY *self, const JARRAY *other) {
+    numeric_binary(self, other, JARRAY_NUMERIC_MUL, "multiply");
+}
+
+static void array_clamp(JARRAY *self, const void *lo, const void *hi) {
+    if (!check_numeric(self, "clamp")) return;
+    if (!lo || !hi)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Clamp bounds cannot be NULL");
+    jarray_numeric_clamp(self->_type_preset, self->_data, self->_length, lo, hi);
+    numeric_modified(self);
+    reset_error_trace();
+}
+
+/// Resolves where a scan of `self` is written: `self` if dst is NULL or self, else `dst` resized to the length of self. NULL on error.
+static JARRAY* scan_destination(JARRAY *self, JARRAY *dst, bool same_preset) {
+    if (!dst || dst == self) return self;
+    if (dst->_elem_size != self->_elem_size || dst->_data_type != JARRAY_TYPE_VALUE) {
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Scan destination must be a value array of element size %zu", self->_elem_size);
+        return NULL;
+    }
+    // Numeric kernels write the source type: a same size destination of another preset would get its raw bits
+    if (same_preset && dst->_type_preset != self->_type_preset) {
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Scan destination must have the preset of the source array");
+        return NULL;
+    }
+    if (dst->_capacity < self->_length) {
+        void *new_data = realloc(dst->_data, self->_length * dst->_elem_size);
+        if (!new_data) {
+            create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for scan destination");
+            return NULL;
+        }
+        dst->_data = new_data;
+        dst->_capacity = self->_length;
+    }
+    dst->_length = self->_length;
+    return dst;
+}
+
+/// Scans `src[begin..end)` into `dst` with a custom op from `carry`, left updated. `tmp` holds one element.
+static void scan_custom_range(const JARRAY *src, JARRAY *dst, size_t begin, size_t end, void *carry, void *tmp, void (*op)(void *acc, const void *elem, void *ctx), void *ctx, bool inclusive) {
+    for (size_t i = begin; i < end; i++) {
+        if (inclusive) {
+            op(carry, elem_at(src, i), ctx);
+            memcpy(elem_at(dst, i), carry, src->_elem_size);
+        } else {
+            // The carry is advanced before the slot is overwritten: dst may be src
+            memcpy(tmp, carry, src->_elem_size);
+            op(carry, elem_at(src, i), ctx);
+            memcpy(elem_at(dst, i), tmp, src->_elem_size);
+        }
+    }
+}
+
+static void array_scan(JARRAY *self, JARRAY *dst, JARRAY_SCAN_OP op, bool inclusive) {
+    if (!check_numeric(self, "scan")) return;
+    if (op > JARRAY_SCAN_MAX)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Unknown scan operation %d", (int)op);
+    JARRAY *target = scan_destination(self, dst, true);
+    if (!target) return;
+    jarray_numeric_scan(self->_type_preset, op, target->_data, self->_data, self->_length, inclusive, NULL);
+    numeric_modified(target);
+    reset_error_trace();
+}
+
+static void array_scan_custom(JARRAY *self, JARRAY *dst, const void *identity, void (*op)(void *acc, const void *elem, void *ctx), void *ctx, bool inclusive) {
+    if (!self)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot scan a NULL JARRAY");
+    if (self->_data_type != JARRAY_TYPE_VALUE)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot scan an array of pointers");
+    if (!identity || !op)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Scan identity and operation cannot be NULL");
+    JARRAY *target = scan_destination(self, dst, false);
+    if (!target) return;
+
+    unsigned char *carry = malloc(2 * self->_elem_size);
+    if (!carry)
+        return create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for scan accumulator");
+    memcpy(carry, identity, self->_elem_size);
+    scan_custom_range(self, target, 0, self->_length, carry, carry + self->_elem_size, op, ctx, inclusive);
+    free(carry);
+    numeric_modified(target);
+    reset_error_trace();
+}
+
+/* ----- PARALLEL ----- */
+
+#define PARALLEL_MIN_CHUNK 1024         // elements per chunk below which scheduling costs more than it saves
+#define PARALLEL_CHUNKS_PER_THREAD 16   // fine chunks, stolen by idle threads when element costs are uneven
+#define PARALLEL_CANCEL_STRIDE 1024     // elements between two checks of the cancellation flag
+
+/// Chunk size splitting `length` elements over the pool, a multiple of 64 so chunks never share a selection bitmap word.
+static size_t parallel_chunk_size(size_t length) {
+    size_t parts = jarray_pool_threads() * PARALLEL_CHUNKS_PER_THREAD;
+    size_t chunk = (length + parts - 1) / parts;
+    if (chunk < PARALLEL_MIN_CHUNK) chunk = PARALLEL_MIN_CHUNK;
+    return (chunk + 63) & ~(size_t)63;
+}
+
+static inline size_t chunk_end(size_t chunk, size_t chunk_size, size_t length) {
+    size_t end = (chunk + 1) * chunk_size;
+    return end < length ? end : length;
+}
+
+static void array_set_thread_count(size_t count) {
+    jarray_pool_set_threads(count);
+    reset_error_trace();
+}
+
+typedef struct PARALLEL_FOR_EACH_CTX {
+    JARRAY *self;
+    size_t chunk_size;
+    void (*callback)(void *elem, void *ctx);
+    void *ctx;
+} PARALLEL_FOR_EACH_CTX;
+
+static void chunk_for_each(size_t chunk, void *ctx) {
+    PARALLEL_FOR_EACH_CTX *each = ctx;
+    size_t end = chunk_end(chunk, each->chunk_size, each->self->_length);
+    for (size_t i = chunk * each->chunk_size; i < end; i++)
+        each->callback(elem_at(each->self, i), each->ctx);
+}
+
+static void array_parallel_for_each(JARRAY *self, void (*callback)(void *elem, void *ctx), void *ctx) {
+    if (!self)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot find element in a NULL JARRAY");
+    if (!callback)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Callback function is null");
+    if (self->_length == 0)
+        return create_return_error(self, JARRAY_EMPTY, "Cannot iterate over an empty array");
+
+    PARALLEL_FOR_EACH_CTX each = { self, parallel_chunk_size(self->_length), callback, ctx };
+    jarray_pool_run((self->_length + each.chunk_size - 1) / each.chunk_size, chunk_for_each, &each);
+    hash_index_invalidate(self);
+    bloom_invalidate(self);
+    reset_error_trace();
+}
+
+typedef struct PARALLEL_FOLD_CTX {
+    JARRAY *self;
+    size_t chunk_size;
+    unsigned char *partials;    // one accumulator per chunk
+    size_t acc_size;
+    void (*fn)(void *acc, const void *elem, void *ctx);
+    void *ctx;
+} PARALLEL_FOLD_CTX;
+
+static void chunk_fold(size_t chunk, void *ctx) {
+    PARALLEL_FOLD_CTX *fold = ctx;
+    void *acc = fold->partials + chunk * fold->acc_size;
+    size_t end = chunk_end(chunk, fold->chunk_size, fold->self->_length);
+    for (size_t i = chunk * fold->chunk_size; i < end; i++)
+        fold->fn(acc, elem_at(fold->self, i), fold->ctx);
+}
+
+static void array_parallel_fold(JARRAY *self, void *acc, size_t acc_size, const void *identity, void (*fn)(void *acc, const void *elem, void *ctx), void (*combine)(void *acc, const void *partial, void *ctx), void *ctx) {
+    if (!self)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot fold a NULL JARRAY");
+    if (!acc || acc_size == 0)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Accumulator cannot be NULL or of size 0");
+    if (!fn || !combine)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Fold and combine functions cannot be NULL");
+    if (self->_length == 0) return reset_error_trace();
+
+    PARALLEL_FOLD_CTX fold = { self, parallel_chunk_size(self->_length), NULL, acc_size, fn, ctx };
+    size_t chunk_count = (self->_length + fold.chunk_size - 1) / fold.chunk_size;
+    fold.partials = malloc(chunk_count * acc_size);
+    if (!fold.partials)
+        return create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for partial accumulators");
+    for (size_t c = 0; c < chunk_count; c++) {
+        if (identity) memcpy(fold.partials + c * acc_size, identity, acc_size);
+        else memset(fold.partials + c * acc_size, 0, acc_size);
+    }
+
+    jarray_pool_run(chunk_count, chunk_fold, &fold);
+    // Partials are combined in chunk order: the combiner only needs to be associative
+    for (size_t c = 0; c < chunk_count; c++)
+        combine(acc, fold.partials + c * acc_size, ctx);
+    free(fold.partials);
+    reset_error_trace();
+}
+
+typedef struct PARALLEL_FILTER_CTX {
+    JARRAY *self;
+    JARRAY *result;
+    size_t chunk_size;
+    bool (*predicate)(const void *elem, const void *ctx);
+    const void *ctx;
+    uint64_t *selection;
+    size_t *offsets;            // number of selected elements per chunk, then offset of the chunk in the result
+} PARALLEL_FILTER_CTX;
+
+static void chunk_filter_select(size_t chunk, void *ctx) {
+    PARALLEL_FILTER_CTX *filter = ctx;
+    size_t end = chunk_end(chunk, filter->chunk_size, filter->self->_length);
+    size_t count = 0;
+    for (size_t i = chunk * filter->chunk_size; i < end; i++) {
+        if (filter->predicate(elem_at(filter->self, i), filter->ctx)) {
+            filter->selection[i / 64] |= (uint64_t)1 << (i % 64);
+            count++;
+        }
+    }
+    filter->offsets[chunk] = count;
+}
+
+static void chunk_filter_copy(size_t chunk, void *ctx) {
+    PARALLEL_FILTER_CTX *filter = ctx;
+    size_t end = chunk_end(chunk, filter->chunk_size, filter->self->_length);
+    size_t j = filter->offsets[chunk];
+    for (size_t w = chunk * filter->chunk_size / 64; w * 64 < end; w++) {
+        for (uint64_t bits = filter->selection[w]; bits; bits &= bits - 1) {
+            size_t i = w * 64 + (size_t)__builtin_ctzll(bits);
+            memcpy_elem(filter->self, elem_at(filter->result, j++), elem_at(filter->self, i), 1);
+        }
+    }
+}
+
+static JARRAY array_parallel_filter(JARRAY *self, bool (*predicate)(const void *elem, const void *ctx), const void *ctx) {
+    if (!self){
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot filter a NULL JARRAY");
+        return (JARRAY){0};
+    }
+    JARRAY result = empty_like(self);
+    if (!predicate){
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Predicate cannot be NULL");
+        return result;
+    }
+    if (self->_length == 0) {
+        reset_error_trace();
+        return result;
+    }
+
+    PARALLEL_FILTER_CTX filter = { self, &result, parallel_chunk_size(self->_length), predicate, ctx, NULL, NULL };
+    size_t chunk_count = (self->_length + filter.chunk_size - 1) / filter.chunk_size;
+    filter.selection = calloc(self->_length / 64 + 1, sizeof(uint64_t));
+    filter.offsets = malloc(chunk_count * sizeof(size_t));
+    if (!filter.selection || !filter.offsets) {
+        free(filter.selection);
+        free(filter.offsets);
+        create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for filter selection");
+        return result;
+    }
+
+    // Select in parallel, turn per chunk counts into offsets, then copy in parallel: the order of the elements is kept
+    jarray_pool_run(chunk_count, chunk_filter_select, &filter);
+    size_t total = 0;
+    for (size_t c = 0; c < chunk_count; c++) {
+        size_t count = filter.offsets[c];
+        filter.offsets[c] = total;
+        total += count;
+    }
+    if (total > 0) {
+        result._data = malloc(total * self->_elem_size);
+        if (!result._data) {
+            free(filter.selection);
+            free(filter.offsets);
+            create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for filtered array");
+            return result;
+        }
+        jarray_pool_run(chunk_count, chunk_filter_copy, &filter);
+    }
+    free(filter.selection);
+    free(filter.offsets);
+    result._length = total;
+    result._min_alloc = total;
+    result._capacity = total;
+    reset_error_trace();
+    return result;
+}
+
+typedef struct PARALLEL_SEARCH_CTX {
+    const JARRAY *self;
+    size_t chunk_size;
+    bool (*predicate)(const void *elem, const void *ctx);
+    const void *ctx;
+    atomic_size_t found;        // smallest matching index found so far, length of the array if none
+} PARALLEL_SEARCH_CTX;
+
+/// Scans a chunk, giving up as soon as a match was found before the elements left to scan.
+static void chunk_find_first(size_t chunk, void *ctx) {
+    PARALLEL_SEARCH_CTX *search = ctx;
+    size_t end = chunk_end(chunk, search->chunk_size, search->self->_length);
+    for (size_t i = chunk * search->chunk_size; i < end; i++) {
+        if (i % PARALLEL_CANCEL_STRIDE == 0 && atomic_load_explicit(&search->found, memory_order_relaxed) < i)
+            return;
+        if (search->predicate(elem_at(search->self, i), search->ctx)) {
+            size_t best = atomic_load(&search->found);
+            while (i < best && !atomic_compare_exchange_weak(&search->found, &best, i))
+                ;
+            return;
+        }
+    }
+}
+
+/// Same as `chunk_find_first`, but any match stops every chunk.
+static void chunk_find_any(size_t chunk, void *ctx) {
+    PARALLEL_SEARCH_CTX *search = ctx;
+    size_t end = chunk_end(chunk, search->chunk_size, search->self->_length);
+    for (size_t i = chunk * search->chunk_size; i < end; i++) {
+        if (i % PARALLEL_CANCEL_STRIDE == 0 && atomic_load_explicit(&search->found, memory_order_relaxed) != search->self->_length)
+            return;
+        if (search->predicate(elem_at(search->self, i), search->ctx)) {
+            atomic_store(&search->found, i);
+            return;
+        }
+    }
+}
+
+static size_t parallel_search(const JARRAY *self, bool (*predicate)(const void *elem, const void *ctx), const void *ctx, void (*scan)(size_t chunk, void *ctx)) {
+    PARALLEL_SEARCH_CTX search = { .self = self, .chunk_size = parallel_chunk_size(self->_length), .predicate = predicate, .ctx = ctx };
+    atomic_init(&search.found, self->_length);
+    jarray_pool_run((self->_length + search.chunk_size - 1) / search.chunk_size, scan, &search);
+    return atomic_load(&search.found);
+}
+
+static bool array_parallel_any(const JARRAY *self, bool (*predicate)(const void *elem, const void *ctx), const void *ctx) {
+    if (!self) {
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot find element in a NULL JARRAY");
+        return false;
+    }
+    if (self->_length == 0) {
+        create_return_error(self, JARRAY_EMPTY, "Cannot check any on an empty array");
+        return false;
+    }
+    if (!predicate) {
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Predicate function is null");
+        return false;
+    }
+    bool found = parallel_search(self, predicate, ctx, chunk_find_any) != self->_length;
+    reset_error_trace();
+    return found;
+}
+
+static size_t array_parallel_find_first_index(JARRAY *self, bool (*predicate)(const void *elem, const void *ctx), const void *ctx) {
+    if (!self) {
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot find element in a NULL JARRAY");
+        return 0;
+    }
+    if (self->_length == 0) {
+        create_return_error(self, JARRAY_EMPTY, "Cannot find element in an empty array");
+        return self->_length;
+    }
+    if (!predicate) {
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot find element with a NULL predicate");
+        return self->_length;
+    }
+    size_t found = parallel_search(self, predicate, ctx, chunk_find_first);
+    if (found == self->_length) {
+        create_return_error(self, JARRAY_ELEMENT_NOT_FOUND, "Found no element corrsponding with predicate conditions");
+        return found;
+    }
+    reset_error_trace();
+    return found;
+}
+
+typedef struct PARALLEL_SCAN_CTX {
+    JARRAY *self;
+    JARRAY *target;
+    size_t chunk_size;
+    bool inclusive;
+    JARRAY_SCAN_OP op;
+    void (*fn)(void *acc, const void *elem, void *ctx); // custom op, NULL for a built-in one
+    void *ctx;
+    const void *identity;
+    unsigned char *carries;     // total of every chunk after the up-sweep, then the carry entering it
+    unsigned char *tmp;         // one scratch element per chunk for custom scans
+} PARALLEL_SCAN_CTX;
+
+static void chunk_scan_reduce(size_t chunk, void *ctx) {
+    PARALLEL_SCAN_CTX *scan = ctx;
+    size_t begin = chunk * scan->chunk_size, end = chunk_end(chunk, scan->chunk_size, scan->self->_length);
+    void *total = scan->carries + chunk * scan->self->_elem_size;
+    if (!scan->fn)
+        return jarray_numeric_reduce(scan->self->_type_preset, scan->op, elem_at(scan->self, begin), end - begin, total);
+    memcpy(total, scan->identity, scan->self->_elem_size);
+    for (size_t i = begin; i < end; i++)
+        scan->fn(total, elem_at(scan->self, i), scan->ctx);
+}
+
+static void chunk_scan_apply(size_t chunk, void *ctx) {
+    PARALLEL_SCAN_CTX *scan = ctx;
+    size_t elem_size = scan->self->_elem_size;
+    size_t begin = chunk * scan->chunk_size, end = chunk_end(chunk, scan->chunk_size, scan->self->_length);
+    void *carry = scan->carries + chunk * elem_size;
+    if (!scan->fn)
+        return jarray_numeric_scan(scan->self->_type_preset, scan->op, elem_at(scan->target, begin), elem_at(scan->self, begin), end - begin, scan->inclusive, carry);
+    scan_custom_range(scan->self, scan->target, begin, end, carry, scan->tmp + chunk * elem_size, scan->fn, scan->ctx, scan->inclusive);
+}
+
+/// Two passes over the pool: every chunk is reduced (up-sweep), the chunk totals are scanned, then every chunk is scanned from its carry (down-sweep).
+static void parallel_scan_run(PARALLEL_SCAN_CTX *scan) {
+    JARRAY *self = scan->self;
+    size_t elem_size = self->_elem_size;
+    scan->chunk_size = parallel_chunk_size(self->_length);
+    size_t chunk_count = (self->_length + scan->chunk_size - 1) / scan->chunk_size;
+
+    // carries, then per chunk scratch elements, then the running carry and a copy of one chunk total
+    scan->carries = malloc((2 * chunk_count + 2) * elem_size);
+    if (!scan->carries)
+        return create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for scan carries");
+    scan->tmp = scan->carries + chunk_count * elem_size;
+    unsigned char *running = scan->tmp + chunk_count * elem_size, *total = running + elem_size;
+
+    // The last chunk total is never used
+    if (chunk_count > 1)
+        jarray_pool_run(chunk_count - 1, chunk_scan_reduce, scan);
+    if (scan->fn) memcpy(running, scan->identity, elem_size);
+    else jarray_numeric_reduce(self->_type_preset, scan->op, NULL, 0, running);
+    for (size_t c = 0; c < chunk_count; c++) {
+        void *slot = scan->carries + c * elem_size;
+        if (c + 1 < chunk_count) {
+            memcpy(total, slot, elem_size);
+            memcpy(slot, running, elem_size);
+            if (scan->fn) scan->fn(running, total, scan->ctx);
+            else jarray_numeric_combine(self->_type_preset, scan->op, running, total);
+        } else {
+            memcpy(slot, running, elem_size);
+        }
+    }
+    jarray_pool_run(chunk_count, chunk_scan_apply, scan);
+    free(scan->carries);
+    numeric_modified(scan->target);
+    reset_error_trace();
+}
+
+static void array_parallel_scan(JARRAY *self, JARRAY *dst, JARRAY_SCAN_OP op, bool inclusive) {
+    if (!check_numeric(self, "scan")) return;
+    if (op > JARRAY_SCAN_MAX)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Unknown scan operation %d", (int)op);
+    JARRAY *target = scan_destination(self, dst, true);
+    if (!target) return;
+    if (self->_length == 0) return reset_error_trace();
+
+    PARALLEL_SCAN_CTX scan = { .self = self, .target = target, .inclusive = inclusive, .op = op };
+    parallel_scan_run(&scan);
+}
+
+static void array_parallel_scan_custom(JARRAY *self, JARRAY *dst, const void *identity, void (*op)(void *acc, const void *elem, void *ctx), void *ctx, bool inclusive) {
+    if (!self)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot scan a NULL JARRAY");
+    if (self->_data_type != JARRAY_TYPE_VALUE)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot scan an array of pointers");
+    if (!identity || !op)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Scan identity and operation cannot be NULL");
+    JARRAY *target = scan_destination(self, dst, false);
+    if (!target) return;
+    if (self->_length == 0) return reset_error_trace();
+
+    PARALLEL_SCAN_CTX scan = { .self = self, .target = target, .inclusive = inclusive, .fn = op, .ctx = ctx, .identity = identity };
+    parallel_scan_run(&scan);
+}
+
+typedef struct PARALLEL_SORT_CTX {
+    JARRAY *self;
+    char *tmp;
+    int (*compare)(const void*, const void*);
+} PARALLEL_SORT_CTX;
+
+typedef struct PARALLEL_SORT_RANGE {
+    PARALLEL_SORT_CTX *sort;
+    size_t lo;
+    size_t hi;
+} PARALLEL_SORT_RANGE;
+
+#define PARALLEL_SORT_GRAIN 8192        // ranges sorted serially with qsort
+
+static void sort_range_task(void *arg);
+
+/// Merge sort: the left half is spawned as a task (nested fork/join), the right half sorted by the current thread.
+static void parallel_sort_range(PARALLEL_SORT_CTX *sort, size_t lo, size_t hi) {
+    JARRAY *self = sort->self;
+    size_t size = self->_elem_size;
+    if (hi - lo <= PARALLEL_SORT_GRAIN) {
+        qsort(elem_at(self, lo), hi - lo, size, sort->compare);
+        return;
+    }
+    size_t mid = lo + (hi - lo) / 2;
+    PARALLEL_SORT_RANGE left = { sort, lo, mid };
+    JARRAY_TASK_GROUP *group = jarray_sched_group_create();
+    if (group) jarray_sched_spawn(group, sort_range_task, &left);
+    else sort_range_task(&left);
+    parallel_sort_range(sort, mid, hi);
+    jarray_sched_group_free(group);
+
+    // Merge both sorted halves through the scratch buffer, taking from the left on ties
+    size_t a = lo, b = mid, out = lo;
+    while (a < mid && b < hi) {
+        if (sort->compare(elem_at(self, b), elem_at(self, a)) < 0)
+            memcpy(sort->tmp + out++ * size, elem_at(self, b++), size);
+        else
+            memcpy(sort->tmp + out++ * size, elem_at(self, a++), size);
+    }
+    memcpy(sort->tmp + out * size, elem_at(self, a), (mid - a) * size);
+    out += mid - a;
+    memcpy(sort->tmp + out * size, elem_at(self, b), (hi - b) * size);
+    memcpy(elem_at(self, lo), sort->tmp + lo * size, (hi - lo) * size);
+}
+
+static void sort_range_task(void *arg) {
+    PARALLEL_SORT_RANGE *range = arg;
+    parallel_sort_range(range->sort, range->lo, range->hi);
+}
+
+static void array_parallel_sort(JARRAY *self, int (*custom_compare_callback)(const void*, const void*)) {
+    if (!self)
+        return create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot find element in a NULL JARRAY");
+    if (self->_length == 0)
+        return create_return_error(self, JARRAY_EMPTY, "Cannot sort an empty array");
+    int (*compare_callback)(const void*, const void*) = custom_compare_callback ? custom_compare_callback : self->user_callbacks.compare_callback;
+    if (compare_callback == NULL)
+        return create_return_error(self, JARRAY_COMPARE_CALLBACK_UNINTIALIZED, "Either compare_callback callback or custom compare_callback function must be set");
+
+    PARALLEL_SORT_CTX sort = { self, NULL, compare_callback };
+    if (self->_length > PARALLEL_SORT_GRAIN) {
+        sort.tmp = malloc(self->_length * self->_elem_size);
+        if (!sort.tmp)
+            return create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed in parallel_sort");
+    }
+    parallel_sort_range(&sort, 0, self->_length);
+    free(sort.tmp);
+    hash_index_invalidate(self);
+    reset_error_trace();
+}
+
+// The task functions may be called from tasks running on any thread: they only touch the error trace on failure
+
+static JARRAY_TASK_GROUP* array_task_group_create(void) {
+    JARRAY_TASK_GROUP *group = jarray_sched_group_create();
+    if (!group)
+        create_return_error(NULL, JARRAY_DATA_NULL, "Memory allocation failed for task group");
+    return group;
+}
+
+static void array_task_spawn(JARRAY_TASK_GROUP *group, void (*fn)(void *arg), void *arg) {
+    if (!group || !fn)
+        return create_return_error(NULL, JARRAY_INVALID_ARGUMENT, "Task group and task function cannot be NULL");
+    jarray_sched_spawn(group, fn, arg);
+}
+
+static void array_task_wait(JARRAY_TASK_GROUP *group) {
+    if (!group)
+        return create_return_error(NULL, JARRAY_INVALID_ARGUMENT, "Cannot wait for a NULL task group");
+    jarray_sched_wait(group);
+}
+
+static void array_task_group_free(JARRAY_TASK_GROUP *group) {
+    jarray_sched_group_free(group);
+}
+
+/* ----- GROUP BY ----- */
+
+#define GROUP_TABLE_MIN_CAPACITY 16
+#define GROUP_PARTITIONS_PER_THREAD 4   // partitions of a parallel group_by, each aggregated into its own table by one task
+#define HISTOGRAM_LANES 4               // interleaved sub-histograms when the counters fit in cache
+#define HISTOGRAM_LANES_MAX_BINS 4096
+
+/// Open addressing (linear probing) table of group_by entries, kept in first occurrence order.
+typedef struct GROUP_TABLE {
+    unsigned char *entries;
+    size_t *hashes;         // hash of the key of every entry
+    size_t count;
+    size_t entry_capacity;
+    size_t *slots;          // index of the entry + 1, 0 means empty slot
+    size_t slot_capacity;   // always a power of two, kept at most half full
+} GROUP_TABLE;
+
+static size_t group_hash(const JARRAY_GROUP_BY_PARAMS *params, const void *key) {
+    if (params->hash_fn) return params->hash_fn(key, params->ctx);
+    if (params->key_size <= sizeof(uint64_t)) {
+        uint64_t bits = 0;
+        memcpy(&bits, key, params->key_size);
+        return jarray_hash_u64(bits);
+    }
+    return jarray_hash_bytes(key, params->key_size);
+}
+
+static inline bool group_equals(const JARRAY_GROUP_BY_PARAMS *params, const void *a, const void *b) {
+    return params->equals_fn ? params->equals_fn(a, b, params->ctx) : memcmp(a, b, params->key_size) == 0;
+}
+
+static bool group_table_grow_slots(GROUP_TABLE *table) {
+    size_t capacity = table->slot_capacity ? table->slot_capacity * 2 : GROUP_TABLE_MIN_CAPACITY;
+    size_t *slots = calloc(capacity, sizeof(size_t));
+    if (!slots) return false;
+    for (size_t e = 0; e < table->count; e++) {
+        size_t pos = table->hashes[e] & (capacity - 1);
+        while (slots[pos] != 0)
+            pos = (pos + 1) & (capacity - 1);
+        slots[pos] = e + 1;
+    }
+    free(table->slots);
+    table->slots = slots;
+    table->slot_capacity = capacity;
+    return true;
+}
+
+static bool group_table_grow_entries(GROUP_TABLE *table, size_t entry_size) {
+    size_t capacity = table->entry_capacity ? table->entry_capacity * 2 : GROUP_TABLE_MIN_CAPACITY;
+    unsigned char *entries = realloc(table->entries, capacity * entry_size);
+    if (!entries) return false;
+    table->entries = entries;
+    size_t *hashes = realloc(table->hashes, capacity * sizeof(size_t));
+    if (!hashes) return false;
+    table->hashes = hashes;
+    table->entry_capacity = capacity;
+    return true;
+}
+
+static void group_table_free(GROUP_TABLE *table) {
+    free(table->entries);
+    free(table->hashes);
+    free(table->slots);
+}
+
+/// Returns the aggregate of `key`, inserting a zeroed entry when the key is new. NULL if an allocation failed.
+static void* group_table_get(GROUP_TABLE *table, const JARRAY_GROUP_BY_PARAMS *params, const void *key, size_t hash) {
+    if (!table->slots && !group_table_grow_slots(table)) return NULL;
+    size_t mask = table->slot_capacity - 1;
+    size_t pos = hash & mask;
+    for (size_t slot; (slot = table->slots[pos]) != 0; pos = (pos + 1) & mask) {
+        unsigned char *entry = table->entries + (slot - 1) * params->entry_size;
+        if (table->hashes[slot - 1] == hash && group_equals(params, entry, key))
+            return entry + params->agg_offset;
+    }
+    if (table->count == table->entry_capacity && !group_table_grow_entries(table, params->entry_size))
+        return NULL;
+    unsigned char *entry = table->entries + table->count * params->entry_size;
+    memset(entry, 0, params->entry_size);
+    memcpy(entry, key, params->key_size);
+    table->hashes[table->count] = hash;
+    table->slots[pos] = ++table->count;
+    if (2 * table->count > table->slot_capacity && !group_table_grow_slots(table))
+        return NULL;
+    return entry + params->agg_offset;
+}
+
+/// Moves the entries of the tables, in order, into a new value array. The tables are freed.
+static JARRAY group_tables_collect(JARRAY *self, GROUP_TABLE *tables, size_t table_count, const JARRAY_GROUP_BY_PARAMS *params) {
+    JARRAY result;
+    array_init(&result, params->entry_size, JARRAY_TYPE_VALUE, (JARRAY_USER_CALLBACK_IMPLEMENTATION){0});
+    if (table_count == 1) {
+        // Single table: its buffer becomes the result
+        result._data = tables[0].entries;
+        result._length = tables[0].count;
+        result._capacity = tables[0].entry_capacity;
+        tables[0].entries = NULL;
+    } else {
+        size_t total = 0;
+        for (size_t t = 0; t < table_count; t++)
+            total += tables[t].count;
+        if (total > 0 && !(result._data = malloc(total * params->entry_size))) {
+            for (size_t t = 0; t < table_count; t++)
+                group_table_free(&tables[t]);
+            create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for group_by result");
+            return result;
+        }
+        for (size_t t = 0; t < table_count; t++) {
+            if (tables[t].count == 0) continue;
+            memcpy(elem_at(&result, result._length), tables[t].entries, tables[t].count * params->entry_size);
+            result._length += tables[t].count;
+        }
+        result._capacity = total;
+    }
+    for (size_t t = 0; t < table_count; t++)
+        group_table_free(&tables[t]);
+    reset_error_trace();
+    return result;
+}
+
+static bool check_group_by_args(JARRAY *self, const JARRAY_GROUP_BY_PARAMS *params) {
+    if (!self) {
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot group a NULL JARRAY");
+        return false;
+    }
+    if (!params || params->entry_size == 0 || params->key_size == 0) {
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Group by parameters must give a key size and an entry size");
+        return false;
+    }
+    if (params->agg_offset < params->key_size || params->agg_offset > params->entry_size) {
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Aggregate offset %zu must be between key size %zu and entry size %zu", params->agg_offset, params->key_size, params->entry_size);
+        return false;
+    }
+    if (!params->key_fn && params->key_size > self->_elem_size) {
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Key size %zu exceeds element size %zu and no key function is set", params->key_size, self->_elem_size);
+        return false;
+    }
+    return true;
+}
+
+static JARRAY array_group_by(JARRAY *self, const JARRAY_GROUP_BY_PARAMS *params) {
+    if (!check_group_by_args(self, params)) {
+        JARRAY result = {0};
+        return result;
+    }
+    GROUP_TABLE table = {0};
+    unsigned char *key = params->key_fn ? malloc(params->key_size) : NULL;
+    if (params->key_fn && !key) {
+        JARRAY result = {0};
+        create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for group_by key");
+        return result;
+    }
+    for (size_t i = 0; i < self->_length; i++) {
+        const void *elem = elem_at(self, i);
+        const void *elem_key = elem;
+        if (params->key_fn) {
+            params->key_fn(elem, key, params->ctx);
+            elem_key = key;
+        }
+        void *agg = group_table_get(&table, params, elem_key, group_hash(params, elem_key));
+        if (!agg) {
+            free(key);
+            group_table_free(&table);
+            JARRAY result = {0};
+            create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed in group_by");
+            return result;
+        }
+        if (params->agg_fn) params->agg_fn(agg, elem, params->ctx);
+    }
+    free(key);
+    return group_tables_collect(self, &table, 1, params);
+}
+
+typedef struct PARALLEL_GROUP_CTX {
+    JARRAY *self;
+    const JARRAY_GROUP_BY_PARAMS *params;
+    size_t chunk_size;
+    size_t partition_count;
+    unsigned char *keys;        // key of every element, NULL when keys are read from the elements
+    size_t *hashes;             // hash of the key of every element
+    size_t *offsets;            // per (chunk, partition): number of elements, then where they go in `order`
+    size_t *order;              // element indexes grouped by partition, increasing within a partition
+    size_t *partition_starts;   // partition_count + 1 bounds in `order`
+    GROUP_TABLE *tables;        // one per partition
+    atomic_bool failed;
+} PARALLEL_GROUP_CTX;
+
+static inline size_t group_partition(size_t hash, size_t partition_count) {
+    // The table slots use the low bits of the hash, the partition is taken from a remix
+    return jarray_hash_u64(hash) % partition_count;
+}
+
+static inline const void* group_key_of(PARALLEL_GROUP_CTX *group, size_t i) {
+    return group->keys ? (const void*)(group->keys + i * group->params->key_size) : (const void*)elem_at(group->self, i);
+}
+
+static void chunk_group_hash(size_t chunk, void *ctx) {
+    PARALLEL_GROUP_CTX *group = ctx;
+    size_t *counts = group->offsets + chunk * group->partition_count;
+    size_t end = chunk_end(chunk, group->chunk_size, group->self->_length);
+    for (size_t i = chunk * group->chunk_size; i < end; i++) {
+        if (group->keys)
+            group->params->key_fn(elem_at(group->self, i), group->keys + i * group->params->key_size, group->params->ctx);
+        group->hashes[i] = group_hash(group->params, group_key_of(group, i));
+        counts[group_partition(group->hashes[i], group->partition_count)]++;
+    }
+}
+
+static void chunk_group_scatter(size_t chunk, void *ctx) {
+    PARALLEL_GROUP_CTX *group = ctx;
+    size_t *offsets = group->offsets + chunk * group->partition_count;
+    size_t end = chunk_end(chunk, group->chunk_size, group->self->_length);
+    for (size_t i = chunk * group->chunk_size; i < end; i++)
+        group->order[offsets[group_partition(group->hashes[i], group->partition_count)]++] = i;
+}
+
+static void partition_group(size_t partition, void *ctx) {
+    PARALLEL_GROUP_CTX *group = ctx;
+    GROUP_TABLE *table = &group->tables[partition];
+    for (size_t o = group->partition_starts[partition]; o < group->partition_starts[partition + 1]; o++) {
+        size_t i = group->order[o];
+        void *agg = group_table_get(table, group->params, group_key_of(group, i), group->hashes[i]);
+        if (!agg) {
+            atomic_store(&group->failed, true);
+            return;
+        }
+        if (group->params->agg_fn) group->params->agg_fn(agg, elem_at(group->self, i), group->params->ctx);
+    }
+}
+
+static JARRAY array_parallel_group_by(JARRAY *self, const JARRAY_GROUP_BY_PARAMS *params) {
+    JARRAY result = {0};
+    if (!check_group_by_args(self, params)) return result;
+
+    size_t length = self->_length;
+    PARALLEL_GROUP_CTX group = { .self = self, .params = params, .chunk_size = parallel_chunk_size(length) };
+    size_t chunk_count = (length + group.chunk_size - 1) / group.chunk_size;
+    group.partition_count = jarray_pool_threads() * GROUP_PARTITIONS_PER_THREAD;
+    atomic_init(&group.failed, false);
+    group.keys = params->key_fn ? malloc(length * params->key_size + 1) : NULL;
+    group.hashes = malloc(length * sizeof(size_t) + 1);
+    group.offsets = calloc(chunk_count * group.partition_count + 1, sizeof(size_t));
+    group.order = malloc(length * sizeof(size_t) + 1);
+    group.partition_starts = malloc((group.partition_count + 1) * sizeof(size_t));
+    group.tables = calloc(group.partition_count, sizeof(GROUP_TABLE));
+    if ((params->key_fn && !group.keys) || !group.hashes || !group.offsets || !group.order || !group.partition_starts || !group.tables) {
+        create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for parallel group_by");
+        goto cleanup;
+    }
+
+    // Hash every element and count it in its partition, then lay the partitions out chunk after chunk
+    jarray_pool_run(chunk_count, chunk_group_hash, &group);
+    size_t offset = 0;
+    for (size_t p = 0; p < group.partition_count; p++) {
+        group.partition_starts[p] = offset;
+        for (size_t c = 0; c < chunk_count; c++) {
+            size_t count = group.offsets[c * group.partition_count + p];
+            group.offsets[c * group.partition_count + p] = offset;
+            offset += count;
+        }
+    }
+    group.partition_starts[group.partition_count] = offset;
+    jarray_pool_run(chunk_count, chunk_group_scatter, &group);
+
+    // Partitions own disjoint keys: every table is built by one task, nothing has to be merged
+    jarray_pool_run(group.partition_count, partition_group, &group);
+    if (atomic_load(&group.failed)) {
+        for (size_t p = 0; p < group.partition_count; p++)
+            group_table_free(&group.tables[p]);
+        create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed in parallel group_by");
+        goto cleanup;
+    }
+    result = group_tables_collect(self, group.tables, group.partition_count, params);
+
+cleanup:
+    free(group.keys);
+    free(group.hashes);
+    free(group.offsets);
+    free(group.order);
+    free(group.partition_starts);
+    free(group.tables);
+    return result;
+}
+
+static bool check_histogram_args(JARRAY *self, long long lo, size_t width, size_t bins, const size_t *counts) {
+    if (!check_numeric(self, "compute the histogram of")) return false;
+    if (self->_type_preset == JARRAY_FLOAT_PRESET || self->_type_preset == JARRAY_DOUBLE_PRESET) {
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Histograms are computed on integer presets only");
+        return false;
+    }
+    if (!counts || width == 0 || bins == 0) {
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Histogram needs a counts array and non zero width and bins");
+        return false;
+    }
+    if (bins > ULLONG_MAX / width) {
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Histogram range overflows");
+        return false;
+    }
+    if (lo < 0 && (self->_type_preset == JARRAY_UINT_PRESET || self->_type_preset == JARRAY_ULONG_PRESET || self->_type_preset == JARRAY_USHORT_PRESET)) {
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Histogram of an unsigned preset cannot start below 0");
+        return false;
+    }
+    return true;
+}
+
+/// Counts `data[0..length)` into `counts`, through interleaved sub-histograms when they fit in cache.
+static bool histogram_range(JARRAY_TYPE_PRESET preset, const void *data, size_t length, long long lo, size_t width, size_t bins, size_t *counts) {
+    if (bins > HISTOGRAM_LANES_MAX_BINS || length < HISTOGRAM_LANES * bins) {
+        jarray_numeric_histogram(preset, data, length, lo, width, bins, 1, counts);
+        return true;
+    }
+    size_t *lanes = calloc(HISTOGRAM_LANES * bins, sizeof(size_t));
+    if (!lanes) return false;
+    jarray_numeric_histogram(preset, data, length, lo, width, bins, HISTOGRAM_LANES, lanes);
+    for (size_t l = 0; l < HISTOGRAM_LANES; l++)
+        for (size_t b = 0; b < bins; b++)
+            counts[b] += lanes[l * bins + b];
+    free(lanes);
+    return true;
+}
+
+static void array_histogram(JARRAY *self, long long lo, size_t width, size_t bins, size_t *counts) {
+    if (!check_histogram_args(self, lo, width, bins, counts)) return;
+    memset(counts, 0, bins * sizeof(size_t));
+    if (!histogram_range(self->_type_preset, self->_data, self->_length, lo, width, bins, counts))
+        return create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for histogram");
+    reset_error_trace();
+}
+
+typedef struct PARALLEL_HISTOGRAM_CTX {
+    JARRAY *self;
+    size_t chunk_size;
+    long long lo;
+    size_t width;
+    size_t bins;
+    size_t *partials;   // bins counters per chunk
+    atomic_bool failed;
+} PARALLEL_HISTOGRAM_CTX;
+
+static void chunk_histogram(size_t chunk, void *ctx) {
+    PARALLEL_HISTOGRAM_CTX *histogram = ctx;
+    size_t begin = chunk * histogram->chunk_size;
+    size_t end = chunk_end(chunk, histogram->chunk_size, histogram->self->_length);
+    if (!histogram_range(histogram->self->_type_preset, elem_at(histogram->self, begin), end - begin, histogram->lo,
+                         histogram->width, histogram->bins, histogram->partials + chunk * histogram->bins))
+        atomic_store(&histogram->failed, true);
+}
+
+static void array_parallel_histogram(JARRAY *self, long long lo, size_t width, size_t bins, size_t *counts) {
+    if (!check_histogram_args(self, lo, width, bins, counts)) return;
+    memset(counts, 0, bins * sizeof(size_t));
+    if (self->_length == 0) return reset_error_trace();
+
+    PARALLEL_HISTOGRAM_CTX histogram = { .self = self, .chunk_size = parallel_chunk_size(self->_length), .lo = lo, .width = width, .bins = bins };
+    size_t chunk_count = (self->_length + histogram.chunk_size - 1) / histogram.chunk_size;
+    atomic_init(&histogram.failed, false);
+    histogram.partials = calloc(chunk_count * bins, sizeof(size_t));
+    if (!histogram.partials)
+        return create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for histogram");
+    jarray_pool_run(chunk_count, chunk_histogram, &histogram);
+    for (size_t c = 0; c < chunk_count; c++)
+        for (size_t b = 0; b < bins; b++)
+            counts[b] += histogram.partials[c * bins + b];
+    free(histogram.partials);
+    if (atomic_load(&histogram.failed))
+        return create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for histogram");
+    reset_error_trace();
+}
+
+/* ----- PIPELINE ----- */
+
+#define PIPELINE_DEFAULT_CHUNK 256
+
+typedef enum PIPELINE_STAGE_KIND {
+    PIPELINE_FILTER,
+    PIPELINE_MAP,
+    PIPELINE_TAKE,
+    PIPELINE_SKIP,
+    PIPELINE_ENUMERATE,
+} PIPELINE_STAGE_KIND;
+
+typedef struct PIPELINE_STAGE {
+    PIPELINE_STAGE_KIND kind;
+    bool (*predicate)(const void *elem, const void *ctx);       // PIPELINE_FILTER
+    void (*map)(const void *elem, void *out, void *ctx);        // PIPELINE_MAP
+    void *ctx;
+    size_t out_elem_size;   // PIPELINE_MAP
+    size_t limit;           // PIPELINE_TAKE, PIPELINE_SKIP
+    size_t seen;            // elements that reached the stage during the current run
+    unsigned char *scratch; // outputs of the stage for one chunk (PIPELINE_MAP, PIPELINE_ENUMERATE)
+} PIPELINE_STAGE;
+
+/// Stages recorded over a source array, executed chunk by chunk by a terminal operation.
+struct JARRAY_PIPELINE {
+    JARRAY *source;
+    PIPELINE_STAGE *stages;
+    size_t stage_count;
+    size_t stage_capacity;
+    size_t elem_size;       // size of the elements produced by the last stage
+    size_t chunk_size;
+};
+
+static void array_pipeline_free(JARRAY_PIPELINE *pipeline) {
+    if (!pipeline) return;
+    for (size_t s = 0; s < pipeline->stage_count; s++)
+        free(pipeline->stages[s].scratch);
+    free(pipeline->stages);
+    free(pipeline);
+}
+
+static JARRAY_PIPELINE* array_pipeline(JARRAY *self) {
+    if (!self) {
+        create_return_error(self, JARRAY_INVALID_ARGUMENT, "Cannot create a pipeline over a NULL JARRAY");
+        return NULL;
+    }
+    JARRAY_PIPELINE *pipeline = calloc(1, sizeof(JARRAY_PIPELINE));
+    if (!pipeline) {
+        create_return_error(self, JARRAY_DATA_NULL, "Memory allocation failed for pipeline");
+        return NULL;
+    }
+    pipeline->source = self;
+    pipeline->elem_size = self->_elem_size;
+    pipeline->chunk_size = PIPELINE_DEFAULT_CHUNK;
+    reset_error_trace();
+    return pipeline;
+}
+
+/// Appends a stage, freeing the pipeline on failure (stages are chained, the caller only keeps the returned pointer).
+static JARRAY_PIPELINE* pipeline_push(JARRAY_PIPELINE *pipeline, PIPELINE_STAGE stage) {
+    if (!pipeline) {
+        create_return_error(NULL, JARRAY_INVALID_ARGUMENT, "Cannot add a stage to a NULL pipeline");
+        return NULL;
+    }
+    if (pipeline->stage_count == pipeline->stage_capacity) {
+        size_t new_cap = pipeline->stage_capacity ? pipeline->stage_capacity * 2 : 4;
+        PIPELINE_STAGE *stages = realloc(pipeline->stages, new_cap * sizeof(PIPELINE_STAGE));
+        if (!stages) {
+            create_return_error(pipeline->source, JARRAY_DATA_NULL, "Memory allocation failed for pipeline stage");
+            array_pipeline_free(pipeline);
+            return NULL;
+        }
+        pipeline->stages = stages;
+        pipeline->stage_capacity = new_cap;
+    }
+    pipeline->stages[pipeline->stage_count++] = stage;
+    reset_error_trace();
+    return pipeline;
+}
+
+static JARRAY_PIPELINE* array_pipeline_filter(JARRAY_PIPELINE *pipeline, bool (*predicate)(const void *elem, const void *ctx), const void *ctx) {
+    if (pipeline && !predicate) {
+        create_return_error(pipeline->source, JARRAY_INVALID_ARGUMENT, "Predicate cannot be NULL");
+        array_pipeline_free(pipeline);
+        return NULL;
+    }
+    return pipeline_push(pipeline, (PIPELINE_STAGE){ .kind = PIPELINE_FILTER, .predicate = predicate, .ctx = (void*)ctx });
+}
+
+static JARRAY_PIPELINE* array_pipeline_map(JARRAY_PIPELINE *pipeline, size_t out_elem_size, void (*fn)(const void *elem, void *out, void *ctx), void *ctx) {
+    if (pipeline && (!fn || out_elem_size == 0)) {
+        create_return_error(pipeline->source, JARRAY_INVALID_ARGUMENT, "Map function cannot be NULL and output element size cannot be 0");
+        array_pipeline_free(pipeline);
+        return NULL;
+    }
+    pipeline = pipeline_push(pipeline, (PIPELINE_STAGE){ .kind = PIPELINE_MAP, .map = fn, .ctx = ctx, .out_elem_size = out_elem_size });
+    if (pipeline) pipeline->elem_size = out_elem_size;
+    return pipeline;
+}
+
+static JARRAY_PIPELINE* array_pipeline_take(JARRAY_PIPELINE *pipeline, size_t count) {
+    return pipeline_push(pipeline, (PIPELINE_STAGE){ .kind = PIPELINE_TAKE, .limit = count });
+}
+
+static JARRAY_PIPELINE* array_pipeline_skip(JARRAY_PIPELINE *pipeline, size_t count) {
+    return pipeline_push(pipeline, (PIPELINE_STAGE){ .kind = PIPELINE_SKIP, .limit = count });
+}
+
+static JARRAY_PIPELINE* array_pipeline_enumerate(JARRAY_PIPELINE *pipeline) {
+    pipeline = pipeline_push(pipeline, (PIPELINE_STAGE){ .kind = PIPELINE_ENUMERATE });
+    if (pipeline) pipeline->elem_size = sizeof(JARRAY_ENUMERATED);
+    return pipeline;
+}
+
+static JARRAY_PIPELINE* array_pipeline_chunk_size(JARRAY_PIPELINE *pipeline, size_t chunk_size) {
+    if (!pipeline) {
+        create_return_error(NULL, JARRAY_INVALID_ARGUMENT, "Cannot set the chunk size of a NULL pipeline");
+        return NULL;
+    }
+    pipeline->chunk_size = chunk_size ? chunk_size : PIPELINE_DEFAULT_CHUNK;
+    reset_error_trace();
+    return pipeline;
+}
+
+/// Passes one chunk of element pointers through a stage, returns the number of items left. Sets `*done` once a take is exhausted.
+static size_t pipeline_apply(PIPELINE_STAGE *stage, const void **items, size_t count, bool *done) {
+    size_t kept = 0;
+    switch (stage->kind) {
+        case PIPELINE_FILTER:
+            for (size_t j = 0; j < count; j++) {
+                if (stage->predicate(items[j], stage->ctx))
+                    items[kept++] = items[j];
+            }
+            return kept;
+        case PIPELINE_MAP:
+            for (size_t j = 0; j < count; j++) {
+                void *out = stage->scratch + j * stage->out_elem_size;
+                stage->map(items[j], out, stage->ctx);
+                items[j] = out;
+            }
+            return count;
+        case PIPELINE_TAKE:
+            if (stage->seen + count >= stage->limit) {
+                count = stage->limit - stage->seen;
+                *done = true;
+            }
+            stage->seen += count;
+            return count;
+        case PIPELINE_SKIP: {
+            size_t skipped = stage->limit - stage->seen;
+            if (skipped > count) skipped = count;
+            stage->seen += skipped;
+            memmove(items, items + skipped, (count - skipped) * sizeof(void*));
+            return count - skipped;
+        }
+        case PIPELINE_ENUMERATE: {
+            JARRAY_ENUMERATED *pairs = (JARRAY_ENUMERATED*)stage->scratch;
+            for (size_t j = 0; j < count; j++) {
+                pairs[j].index = stage->seen++;
+                pairs[j].value = items[j];
+                items[j] = &pairs[j];
+            }
+            return count;
+        }
+    }
+    return count;
+}
+
+/**
+ * Executes the pipeline: each chunk of the source goes through every stage while it is hot in cache, then `sink` receives
+ * the surviving items. Stops when `sink` returns false or a take is exhausted. Returns false on allocation failure.
+ */
+static bool pipeline_run(JARRAY_PIPELINE *pipeline, bool (*sink)(const void **items, size_t count, void *ctx), void *ctx) {
+    size_t chunk = pipeline->chunk_size;
+    const void **items = malloc(chunk * sizeof(void*));
+    if (!items) return false;
+    bool done = false;
+    for (size_t s = 0; s < pipeline->stage_count; s++) {
+        PIPELINE_STAGE *stage = &pipeline->stages[s];
+        stage->seen = 0;
+        if (stage->kind == PIPELINE_TAKE && stage->limit == 0) done = true;
+        size_t scratch_size = stage->kind == PIPELINE_MAP ? stage->out_elem_size
+                            : stage->kind == PIPELINE_ENUMERATE ? sizeof(JARRAY_ENUMERATED) : 0;
+        if (scratch_size && !stage->scratch) {
+            stage->scratch = malloc(chunk * scratch_size);
+            if (!stage->scratch) {
+                free(items);
+                return false;
+            }
+        }
+    }
+
+    JARRAY *source = pipeline->source;
+    for (size_t start = 0; start < source->_length && !done; start += chunk) {
+        size_t count = source->_length - start < chunk ? source->_length - start : chunk;
+        for (size_t j = 0; j < count; j++)
+            items[j] = elem_at(source, start + j);
+        for (size_t s = 0; s < pipeline->stage_count && count > 0; s++)
+            count = pipeline_apply(&pipeline->stages[s], items, count, &done);
+        if (count > 0 && !sink(items, count, ctx))
+            break;
+    }
+    free(items);
+    return true;
+}
+
+/// Runs the pipeline then frees it, reporting allocation failures on the source array.
+static bool pipeline_consume(JARRAY_PIPELINE *pipeline, bool (*sink)(const void **items, size_t count, void *ctx), void *ctx) {
+    JARRAY *source = pipeline->source;
+    bool ok = pipeline_run(pipeline, sink, ctx);
+    array_pipeline_free(pipeline);
+    if (!ok) {
+        create_return_error(source, JARRAY_DATA_NULL, "Memory allocation failed when running pipeline");
+        return false;
+    }
+    return true;
+}
+
+static bool check_pipeline(const JARRAY_PIPELINE *pipeline) {
+    if (!pipeline) {
+        create_return_error(NULL, JARRAY_INVALID_ARGUMENT, "Cannot run a NULL pipeline");
+        return false;
+    }
+    return true;
+}
+
+typedef struct PIPELINE_COLLECT_CTX {
+    JARRAY *result;
+    bool failed;
+} PIPELINE_COLLECT_CTX;
+
+static bool sink_collect(const void **items, size_t count, void *ctx) {
+    PIPELINE_COLLECT_CTX *collect = ctx;
+    JARRAY *result = collect->result;
+    if (result->_length + count > result->_capacity) {
+        size_t new_cap = max_size_t(result->_capacity * 2, result->_length + count);
+        void *new_data = realloc(result->_data, new_cap * result->_elem_size);
+        if (!new_data) {
+            collect->failed = true;
+            return false;
+        }
+        result->_data = new_data;
+        result->_capacity = new_cap;
+    }
+    for (size_t j = 0; j < count; j++)
+        memcpy_elem(result, elem_at(result, result->_length + j), items[j], 1);
+    result->_length += count;
+    return true;
+}
+
+static void pipeline_collect_into(JARRAY_PIPELINE *pipeline, JARRAY *result) {
+    JARRAY *source = pipeline->source;
+    PIPELINE_COLLECT_CTX collect = { result, false };
+    if (!pipeline_consume(pipeline, sink_collect, &collect)) return;
+    if (collect.failed)
+        return create_return_error(source, JARRAY_DATA_NULL, "Memory allocation failed when collecting pipeline");
+    if (result->_length > 0 && result->_length < result->_capacity) {
+        void *shrunk = realloc(result->_data, result->_length * result->_elem_size);
+        if (shrunk) {
+            result->_data = shrunk;
+            result->_capacity = result->_length;
+        }
+    }
+    result->_min_alloc = result->_length;
+    reset_error_trace();
+}
+
+static JARRAY array_pipeline_collect(JARRAY_PIPELINE *pipeline, JARRAY_DATA_TYPE out_type, JARRAY_USER_CALLBACK_IMPLEMENTATION out_callbacks) {
+    JARRAY result;
+    jarray.init(&result, pipeline ? pipeline->elem_size : 0, out_type, out_callbacks);
+    if (!check_pipeline(pipeline)) return result;
+    if (last_error_trace.has_error) {
+        array_pipeline_free(pipeline);
+        return result;
+    }
+    pipeline_collect_into(pipeline, &result);
+    return result;
+}
+
+static JARRAY array_pipeline_collect_preset(JARRAY_PIPELINE *pipeline, JARRAY_TYPE_PRESET preset) {
+    JARRAY result = jarray.init_preset(preset);
+    if (!check_pipeline(pipeline)) return result;
+    if (last_error_trace.has_error) {
+        array_pipeline_free(pipeline);
+        return result;
+    }
+    size_t elem_size = pipeline->elem_size;
+    if (result._elem_size != elem_size) {
+        array_pipeline_free(pipeline);
+        create_return_error(NULL, JARRAY_INVALID_ARGUMENT, "Pipeline elements size %zu does not match preset size %zu", elem_size, result._elem_size);
+        return result;
+    }
+    pipeline_collect_into(pipeline, &result);
+    return result;
+}
+
+typedef struct PIPELINE_REDUCE_CTX {
+    void *acc;
+    void (*fn)(void *acc, const void *elem, void *ctx);
+    void *ctx;
+} PIPELINE_REDUCE_CTX;
+
+static bool sink_reduce(const void **items, size_t count, void *ctx) {
+    PIPELINE_REDUCE_CTX *reduce = ctx;
+    for (size_t j = 0; j < count; j++)
+        reduce->fn(reduce->acc, items[j], reduce->ctx);
+    return true;
+}
+
+static void array_pipeline_reduce(JARRAY_PIPELINE *pipeline, void *acc, void (*fn)(void *acc, const void *elem, void *ctx), void *ctx) {
+    if (!check_pipeline(pipeline)) return;
+    if (!acc || !fn) {
+        create_return_error(pipeline->source, JARRAY_INVALID_ARGUMENT, "Accumulator and reduce function cannot be NULL");
+        return array_pipeline_free(pipeline);
+    }
+    PIPELINE_REDUCE_CTX reduce = { acc, fn, ctx };
+    if (pipeline_consume(pipeline, sink_reduce, &reduce))
+        reset_error_trace();
+}
+
+static bool sink_count(const void **items, size_t count, void *ctx) {
+    (void)items;
+    *(size_t*)ctx += count;
+    return true;
+}
+
+static size_t array_pipeline_count(JARRAY_PIPELINE *pipeline) {
+    if (!check_pipeline(pipeline)) return 0;
+    size_t count = 0;
+    if (pipeline_consume(pipeline, sink_count, &count))
+        reset_error_trace();
+    return count;
+}
+
+typedef struct PIPELINE_ANY_CTX {
+    bool (*predicate)(const void *elem, const void *ctx);
+    const void *ctx;
+    bool found;
+} PIPELINE_ANY_CTX;
+
+static bool sink_any(const void **items, size_t count, void *ctx) {
+    PIPELINE_ANY_CTX *any = ctx;
+    for (size_t j = 0; j < count; j++) {
+        if (!any->predicate || any->predicate(items[j], any->ctx)) {
+            any->found = true;
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool array_pipeline_any(JARRAY_PIPELINE *pipeline, bool (*predicate)(const void *elem, const void *ctx), const void *ctx) {
+    if (!check_pipeline(pipeline)) return false;
+    PIPELINE_ANY_CTX any = { predicate, ctx, false };
+    if (pipeline_consume(pipeline, sink_any, &any))
+        reset_error_trace();
+    return any.found;
+}
+
+typedef struct PIPELINE_FOR_EACH_CTX {
+    void (*callback)(const void *elem, void *ctx);
+    void *ctx;
+} PIPELINE_FOR_EACH_CTX;
+
+static bool sink_for_each(const void **items, size_t count, void *ctx) {
+    PIPELINE_FOR_EACH_CTX *each = ctx;
+    for (size_t j = 0; j < count; j++)
+        each->callback(items[j], each->ctx);
+    return true;
+}
+
+static void array_pipeline_for_each(JARRAY_PIPELINE *pipeline, void (*callback)(const void *elem, void *ctx), void *ctx) {
+    if (!check_pipeline(pipeline)) return;
+    if (!callback) {
+        create_return_error(pipeline->source, JARRAY_INVALID_ARGUMENT, "Callback cannot be NULL");
+        return array_pipeline_free(pipeline);
+    }
+    PIPELINE_FOR_EACH_CTX each = { callback, ctx };
+    if (pipeline_consume(pipeline, sink_for_each, &each))
+        reset_error_trace();
+}
+
+typedef struct PIPELINE_FIRST_CTX {
+    void *out;
+    size_t elem_size;
+    bool found;
+} PIPELINE_FIRST_CTX;
+
+static bool sink_first(const void **items, size_t count, void *ctx) {
+    (void)count;
+    PIPELINE_FIRST_CTX *first = ctx;
+    memcpy(first->out, items[0], first->elem_size);
+    first->found = true;
+    return false;
+}
+
+static bool array_pipeline_first(JARRAY_PIPELINE *pipeline, void *out) {
+    if (!check_pipeline(pipeline)) return false;
+    if (!out) {
+        create_return_error(pipeline->source, JARRAY_INVALID_ARGUMENT, "Output pointer cannot be NULL");
+        array_pipeline_free(pipeline);
+        return false;
+    }
+    JARRAY *source = pipeline->source;
+    PIPELINE_FIRST_CTX first = { out, pipeline->elem_size, false };
+    if (!pipeline_consume(pipeline, sink_first, &first)) return false;
+    if (!first.found) {
+        create_return_error(source, JARRAY_ELEMENT_NOT_FOUND, "Pipeline produced no element");
+        return false;
+    }
+    reset_error_trace();
+    return true;
+}
+
 extern JARRAY create_jarray_string(void);
 extern JARRAY create_jarray_int(void);
 extern JARRAY create_jarray_float(void);
@@ -1422,17 +4130,21 @@ static JARRAY array_init_preset(JARRAY_TYPE_PRESET preset){
 /// Static interface implementation for easier usage.
 JARRAY_INTERFACE jarray = {
     .filter = array_filter,
+    .filter_into = array_filter_into,
     .at = array_at,
     .add = array_add,
     .remove = array_remove,
     .remove_at = array_remove_at,
     .add_at = array_add_at,
     .print = array_print,
+    .print_to = array_print_to,
+    .print_fd = array_print_fd,
     .init = array_init,
     .init_with_data_copy = array_init_with_data_copy,
     .init_with_data = array_init_with_data,
     .init_preset = array_init_preset,
     .print_jarray_err = print_array_err,
+    .error_message = error_message,
     .free = array_free,
     .sort = array_sort,
     .find_first = array_find_first,
@@ -1450,9 +4162,11 @@ JARRAY_INTERFACE jarray = {
     .reduce = array_reduce,
     .concat = array_concat,
     .join = array_join,
+    .write_to = array_write_to,
     .reverse = array_reverse,
     .any = array_any,
     .reduce_right = array_reduce_right,
+    .fold = array_fold,
     .find_last = array_find_last,
     .find_first_index = array_find_first_index,
     .find_last_index = array_find_last_index,
@@ -1463,4 +4177,68 @@ JARRAY_INTERFACE jarray = {
     .addm = array_addm,
     .reserve = array_reserve,
     .init_reserve = array_init_reserve,
+    .attach_hash_index = array_attach_hash_index,
+    .detach_hash_index = array_detach_hash_index,
+    .index_of = array_index_of,
+    .indexes_of_jarray = array_indexes_of_jarray,
+    .matches_bitmap = array_matches_bitmap,
+    .count_of = array_count_of,
+    .for_each_match = array_for_each_match,
+    .attach_bloom_filter = array_attach_bloom_filter,
+    .rebuild_bloom_filter = array_rebuild_bloom_filter,
+    .detach_bloom_filter = array_detach_bloom_filter,
+    .contains_many = array_contains_many,
+    .index_of_many = array_index_of_many,
+    .map = array_map,
+    .map_preset = array_map_preset,
+    .pipeline = array_pipeline,
+    .pipeline_filter = array_pipeline_filter,
+    .pipeline_map = array_pipeline_map,
+    .pipeline_take = array_pipeline_take,
+    .pipeline_skip = array_pipeline_skip,
+    .pipeline_enumerate = array_pipeline_enumerate,
+    .pipeline_chunk_size = array_pipeline_chunk_size,
+    .pipeline_collect = array_pipeline_collect,
+    .pipeline_collect_preset = array_pipeline_collect_preset,
+    .pipeline_reduce = array_pipeline_reduce,
+    .pipeline_count = array_pipeline_count,
+    .pipeline_any = array_pipeline_any,
+    .pipeline_for_each = array_pipeline_for_each,
+    .pipeline_first = array_pipeline_first,
+    .pipeline_free = array_pipeline_free,
+    .set_thread_count = array_set_thread_count,
+    .parallel_for_each = array_parallel_for_each,
+    .parallel_fold = array_parallel_fold,
+    .parallel_filter = array_parallel_filter,
+    .parallel_any = array_parallel_any,
+    .parallel_find_first_index = array_parallel_find_first_index,
+    .parallel_sort = array_parallel_sort,
+    .task_group_create = array_task_group_create,
+    .task_spawn = array_task_spawn,
+    .task_wait = array_task_wait,
+    .task_group_free = array_task_group_free,
+    .sum = array_sum,
+    .mean = array_mean,
+    .min = array_min,
+    .max = array_max,
+    .argmin = array_argmin,
+    .argmax = array_argmax,
+    .dot = array_dot,
+    .scale = array_scale,
+    .axpy = array_axpy,
+    .add_array = array_add_array,
+    .sub_array = array_sub_array,
+    .mul_array = array_mul_array,
+    .clamp = array_clamp,
+    .scan = array_scan,
+    .scan_custom = array_scan_custom,
+    .parallel_scan = array_parallel_scan,
+    .parallel_scan_custom = array_parallel_scan_custom,
+    .group_by = array_group_by,
+    .parallel_group_by = array_parallel_group_by,
+    .histogram = array_histogram,
+    .parallel_histogram = array_parallel_histogram,
+    .for_each_chunk = array_for_each_chunk,
+    .any_chunk = array_any_chunk,
+    .find_first_chunk = array_find_first_chunk,
 };
\ No newline at end of file
@@ -0,0 +1,281 @@
+#include "../inc/jarray_concurrent.h"
+#include "jarray_internal.h"
+#include <limits.h>
+#include <stdatomic.h>
+
+/**
+ * @file jarray_concurrent.c
+ * @brief Append-only array of doubling buckets: slots reserved by fetch-add, published in order through per slot flags.
+ */
+
+#define CONCURRENT_FIRST_SHIFT 6
+#define CONCURRENT_FIRST_BUCKET ((size_t)1 << CONCURRENT_FIRST_SHIFT)
+#define CONCURRENT_BUCKETS (sizeof(size_t) * CHAR_BIT - CONCURRENT_FIRST_SHIFT)
+#define CONCURRENT_CACHE_LINE 64
+
+/*
+ * Bucket b holds CONCURRENT_FIRST_BUCKET << b elements, followed by one ready flag per element.
+ * Both counters get their own cache line: producers hammer `reserved`, the publishing thread `published`.
+ */
+struct JARRAY_CONCURRENT {
+    JARRAY model;                                   // element size, type and callbacks, holds no data
+    _Atomic(unsigned char*) buckets[CONCURRENT_BUCKETS];
+    _Alignas(CONCURRENT_CACHE_LINE) atomic_size_t reserved;
+    _Alignas(CONCURRENT_CACHE_LINE) atomic_size_t published;
+};
+
+typedef struct SLOT {
+    size_t bucket;
+    size_t offset;
+} SLOT;
+
+/// Bucket and position of an index: `index + FIRST` has its highest bit at `bucket + FIRST_SHIFT`.
+static inline SLOT slot_of(size_t index) {
+    size_t shifted = index + CONCURRENT_FIRST_BUCKET;
+    size_t high_bit = sizeof(unsigned long long) * CHAR_BIT - 1 - (size_t)__builtin_clzll((unsigned long long)shifted);
+    SLOT slot = { high_bit - CONCURRENT_FIRST_SHIFT, shifted - ((size_t)1 << high_bit) };
+    return slot;
+}
+
+static inline size_t bucket_capacity(size_t bucket) {
+    return CONCURRENT_FIRST_BUCKET << bucket;
+}
+
+static inline size_t bucket_start(size_t bucket) {
+    return bucket_capacity(bucket) - CONCURRENT_FIRST_BUCKET;
+}
+
+static inline _Atomic unsigned char *bucket_flags(const JARRAY_CONCURRENT *array, unsigned char *bucket, size_t bucket_index) {
+    return (_Atomic unsigned char*)(bucket + bucket_capacity(bucket_index) * array->model._elem_size);
+}
+
+/// Bucket `index`, allocated by the first thread needing it. Losers of the race free their copy.
+static unsigned char *bucket_get(JARRAY_CONCURRENT *array, size_t index) {
+    unsigned char *bucket = atomic_load_explicit(&array->buckets[index], memory_order_acquire);
+    if (bucket) return bucket;
+
+    size_t capacity = bucket_capacity(index);
+    unsigned char *fresh = malloc(capacity * array->model._elem_size + capacity);
+    if (!fresh) return NULL;
+    memset(fresh + capacity * array->model._elem_size, 0, capacity);
+    if (!atomic_compare_exchange_strong_explicit(&array->buckets[index], &bucket, fresh, memory_order_acq_rel, memory_order_acquire)) {
+        free(fresh);
+        return bucket;
+    }
+    return fresh;
+}
+
+static bool slot_ready(const JARRAY_CONCURRENT *array, size_t index) {
+    SLOT slot = slot_of(index);
+    if (slot.bucket >= CONCURRENT_BUCKETS) return false;
+    unsigned char *bucket = atomic_load_explicit(&array->buckets[slot.bucket], memory_order_acquire);
+    return bucket && atomic_load(&bucket_flags(array, bucket, slot.bucket)[slot.offset]);
+}
+
+/*
+ * Moves `published` over the run of ready slots following it. Every producer calls it after raising its flags,
+ * so a slot written after a publisher stopped in front of it is published by its own producer.
+ * Flags and counter use sequentially consistent accesses: a producer raising its flag and a publisher moving
+ * the counter cannot both miss each other.
+ */
+static void publish(JARRAY_CONCURRENT *array) {
+    size_t published = atomic_load(&array->published);
+    for (;;) {
+        size_t end = published;
+        while (slot_ready(array, end)) end++;
+        if (end == published) return;
+        if (atomic_compare_exchange_weak(&array->published, &published, end)) published = end;
+    }
+}
+
+static bool check_concurrent(const JARRAY_CONCURRENT *array, const char *action) {
+    if (!array) {
+        jarray_internal_error(NULL, JARRAY_INVALID_ARGUMENT, "Cannot %s a NULL JARRAY_CONCURRENT", action);
+        return false;
+    }
+    return true;
+}
+
+static JARRAY_CONCURRENT *concurrent_create(size_t elem_size, JARRAY_DATA_TYPE data_type, JARRAY_USER_CALLBACK_IMPLEMENTATION user_callbacks) {
+    if (elem_size == 0) {
+        jarray_internal_error(NULL, JARRAY_INVALID_ARGUMENT, "Element size of a JARRAY_CONCURRENT cannot be 0");
+        return NULL;
+    }
+    JARRAY_CONCURRENT *array = aligned_alloc(CONCURRENT_CACHE_LINE, sizeof(JARRAY_CONCURRENT));
+    if (!array) {
+        jarray_internal_error(NULL, JARRAY_DATA_NULL, "Memory allocation failed for JARRAY_CONCURRENT");
+        return NULL;
+    }
+    jarray.init(&array->model, elem_size, data_type, user_callbacks);
+    if (last_error_trace.has_error) {
+        free(array);
+        return NULL;
+    }
+    for (size_t b = 0; b < CONCURRENT_BUCKETS; b++)
+        atomic_init(&array->buckets[b], NULL);
+    atomic_init(&array->reserved, 0);
+    atomic_init(&array->published, 0);
+    jarray_internal_reset_error();
+    return array;
+}
+
+static JARRAY_CONCURRENT *concurrent_create_preset(JARRAY_TYPE_PRESET preset) {
+    JARRAY model = jarray.init_preset(preset);
+    if (last_error_trace.has_error) return NULL;
+    JARRAY_CONCURRENT *array = concurrent_create(model._elem_size, model._data_type, model.user_callbacks);
+    if (array) array->model._type_preset = model._type_preset;
+    jarray.free(&model);
+    if (array) jarray_internal_reset_error();
+    return array;
+}
+
+static void concurrent_free(JARRAY_CONCURRENT *array) {
+    if (!array) return;
+    for (size_t b = 0; b < CONCURRENT_BUCKETS; b++) {
+        unsigned char *bucket = atomic_load_explicit(&array->buckets[b], memory_order_acquire);
+        if (!bucket) continue;
+        if (array->model._data_type == JARRAY_TYPE_POINTER) {
+            _Atomic unsigned char *flags = bucket_flags(array, bucket, b);
+            for (size_t i = 0; i < bucket_capacity(b); i++)
+                if (atomic_load_explicit(&flags[i], memory_order_relaxed))
+                    jarray_internal_free_elems(&array->model, bucket + i * array->model._elem_size, 1);
+        }
+        free(bucket);
+    }
+    jarray.free(&array->model);
+    free(array);
+}
+
+static void concurrent_reserve(JARRAY_CONCURRENT *array, size_t capacity) {
+    if (!check_concurrent(array, "reserve")) return;
+    if (capacity == 0) return jarray_internal_reset_error();
+    size_t last = slot_of(capacity - 1).bucket;
+    if (last >= CONCURRENT_BUCKETS)
+        return jarray_internal_error(NULL, JARRAY_INVALID_ARGUMENT, "Capacity %zu too large for a JARRAY_CONCURRENT", capacity);
+    for (size_t b = 0; b <= last; b++) {
+        if (!bucket_get(array, b))
+            return jarray_internal_error(NULL, JARRAY_DATA_NULL, "Memory allocation failed for JARRAY_CONCURRENT bucket");
+    }
+    jarray_internal_reset_error();
+}
+
+static size_t concurrent_push_n(JARRAY_CONCURRENT *array, const void *elems, size_t count) {
+    if (!check_concurrent(array, "push to")) return SIZE_MAX;
+    if (!elems || count == 0) {
+        jarray_internal_error(NULL, JARRAY_INVALID_ARGUMENT, "Elements are NULL or count is zero");
+        return SIZE_MAX;
+    }
+
+    size_t first = atomic_fetch_add_explicit(&array->reserved, count, memory_order_relaxed);
+    const unsigned char *src = (const unsigned char*)elems;
+    size_t elem_size = array->model._elem_size;
+
+    // The reserved range may span buckets: copy it piece by piece, then raise the flags of the piece
+    for (size_t done = 0; done < count;) {
+        SLOT slot = slot_of(first + done);
+        unsigned char *bucket = slot.bucket < CONCURRENT_BUCKETS ? bucket_get(array, slot.bucket) : NULL;
+        if (!bucket) {
+            jarray_internal_error(NULL, JARRAY_DATA_NULL, "Memory allocation failed for JARRAY_CONCURRENT bucket");
+            return SIZE_MAX;
+        }
+        size_t piece = bucket_capacity(slot.bucket) - slot.offset;
+        if (piece > count - done) piece = count - done;
+
+        jarray_internal_copy_elems(&array->model, bucket + slot.offset * elem_size, src + done * elem_size, piece);
+        _Atomic unsigned char *flags = bucket_flags(array, bucket, slot.bucket);
+        for (size_t i = 0; i < piece; i++)
+            atomic_store(&flags[slot.offset + i], 1);
+        done += piece;
+    }
+
+    publish(array);
+    jarray_internal_reset_error();
+    return first;
+}
+
+static size_t concurrent_push(JARRAY_CONCURRENT *array, const void *elem) {
+    return concurrent_push_n(array, elem, 1);
+}
+
+static size_t concurrent_length(const JARRAY_CONCURRENT *array) {
+    if (!check_concurrent(array, "get the length of")) return 0;
+    jarray_internal_reset_error();
+    return atomic_load_explicit(&array->published, memory_order_acquire);
+}
+
+static void *concurrent_at(const JARRAY_CONCURRENT *array, size_t index) {
+    if (!check_concurrent(array, "access")) return NULL;
+    size_t length = atomic_load_explicit(&array->published, memory_order_acquire);
+    if (index >= length) {
+        jarray_internal_error(NULL, JARRAY_INDEX_OUT_OF_BOUND, "Index %zu out of bound for %zu published elements", index, length);
+        return NULL;
+    }
+    SLOT slot = slot_of(index);
+    unsigned char *bucket = atomic_load_explicit(&array->buckets[slot.bucket], memory_order_acquire);
+    jarray_internal_reset_error();
+    return bucket + slot.offset * array->model._elem_size;
+}
+
+/// Calls `visit(elements, count, start, ctx)` on the contiguous pieces of the first `length` elements.
+static void visit_prefix(const JARRAY_CONCURRENT *array, size_t length, void (*visit)(unsigned char*, size_t, size_t, void*), void *ctx) {
+    for (size_t b = 0; b < CONCURRENT_BUCKETS && bucket_start(b) < length; b++) {
+        unsigned char *bucket = atomic_load_explicit(&array->buckets[b], memory_order_acquire);
+        size_t count = bucket_capacity(b);
+        if (count > length - bucket_start(b)) count = length - bucket_start(b);
+        visit(bucket, count, bucket_start(b), ctx);
+    }
+}
+
+typedef struct FOR_EACH_CTX {
+    size_t elem_size;
+    void (*callback)(const void*, size_t, void*);
+    void *ctx;
+} FOR_EACH_CTX;
+
+static void for_each_piece(unsigned char *elements, size_t count, size_t start, void *ctx) {
+    FOR_EACH_CTX *c = ctx;
+    for (size_t i = 0; i < count; i++)
+        c->callback(elements + i * c->elem_size, start + i, c->ctx);
+}
+
+static void concurrent_for_each(const JARRAY_CONCURRENT *array, void (*callback)(const void *elem, size_t index, void *ctx), void *ctx) {
+    if (!check_concurrent(array, "iterate")) return;
+    if (!callback)
+        return jarray_internal_error(NULL, JARRAY_INVALID_ARGUMENT, "Callback function is NULL");
+    FOR_EACH_CTX c = { array->model._elem_size, callback, ctx };
+    visit_prefix(array, atomic_load_explicit(&array->published, memory_order_acquire), for_each_piece, &c);
+    jarray_internal_reset_error();
+}
+
+static void to_array_piece(unsigned char *elements, size_t count, size_t start, void *ctx) {
+    (void)start;
+    jarray.add_all((JARRAY*)ctx, elements, count);
+}
+
+static JARRAY concurrent_to_array(const JARRAY_CONCURRENT *array) {
+    JARRAY result = {0};
+    if (!check_concurrent(array, "copy")) return result;
+    jarray.init(&result, array->model._elem_size, array->model._data_type, array->model.user_callbacks);
+    result._type_preset = array->model._type_preset;
+    size_t length = atomic_load_explicit(&array->published, memory_order_acquire);
+    if (length > 0) {
+        jarray.reserve(&result, length);
+        visit_prefix(array, length, to_array_piece, &result);
+        if (last_error_trace.has_error) return result;
+    }
+    jarray_internal_reset_error();
+    return result;
+}
+
+JARRAY_CONCURRENT_INTERFACE jarray_concurrent = {
+    .create = concurrent_create,
+    .create_preset = concurrent_create_preset,
+    .free = concurrent_free,
+    .reserve = concurrent_reserve,
+    .push = concurrent_push,
+    .push_n = concurrent_push_n,
+    .length = concurrent_length,
+    .at = concurrent_at,
+    .for_each = concurrent_for_each,
+    .to_array = concurrent_to_array,
+};
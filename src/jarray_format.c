@@ -0,0 +1,130 @@
+#include "jarray_format.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @file jarray_format.c
+ * @brief Decimal formatting without printf for the numeric presets.
+ */
+
+static const char digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static const unsigned long long powers_of_10[20] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+    1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+    100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+    1000000000000000000ULL, 10000000000000000000ULL,
+};
+
+/// Number of decimal digits (1 for zero), from the bit length (log10(2) ~ 1233 / 4096) and one table compare.
+static inline size_t decimal_digits(unsigned long long value) {
+    size_t guess = (size_t)(64 - __builtin_clzll(value | 1)) * 1233 >> 12;
+    return guess + ((value | 1) >= powers_of_10[guess]);
+}
+
+size_t jarray_format_u64(char *out, unsigned long long value) {
+    size_t length = decimal_digits(value);
+    char *end = out + length;
+    while (value >= 100) {
+        size_t pair = (size_t)(value % 100) * 2;
+        value /= 100;
+        *--end = digit_pairs[pair + 1];
+        *--end = digit_pairs[pair];
+    }
+    if (value >= 10) {
+        *--end = digit_pairs[value * 2 + 1];
+        *--end = digit_pairs[value * 2];
+    } else {
+        *--end = (char)('0' + value);
+    }
+    return length;
+}
+
+size_t jarray_format_i64(char *out, long long value) {
+    // Negated in unsigned arithmetic, LLONG_MIN has no positive counterpart
+    unsigned long long magnitude = (unsigned long long)value;
+    if (value < 0) {
+        *out++ = '-';
+        magnitude = 0ULL - magnitude;
+    }
+    return (value < 0) + jarray_format_u64(out, magnitude);
+}
+
+size_t jarray_format_fixed2(char *out, double value) {
+    double magnitude = value < 0 ? -value : value;
+    if (!(magnitude < 2147483648.0))
+        return (size_t)snprintf(out, JARRAY_FORMAT_MAX, "%.2f", value);
+
+    // magnitude * 100 < 2^38 is off by at most 2^-15 from the exact product, it only matters near a .5 tie
+    double scaled = magnitude * 100.0;
+    unsigned long long whole = (unsigned long long)scaled;
+    double fraction = scaled - (double)whole;
+    if (fraction > 0.5 - 1e-4 && fraction < 0.5 + 1e-4)
+        return (size_t)snprintf(out, JARRAY_FORMAT_MAX, "%.2f", value);
+    whole += fraction > 0.5;
+
+    char *cursor = out;
+    if (signbit(value)) *cursor++ = '-';
+    cursor += jarray_format_u64(cursor, whole / 100);
+    size_t cents = (size_t)(whole % 100) * 2;
+    cursor[0] = '.';
+    cursor[1] = digit_pairs[cents];
+    cursor[2] = digit_pairs[cents + 1];
+    return (size_t)(cursor + 3 - out);
+}
+
+bool jarray_format_supported(JARRAY_TYPE_PRESET preset) {
+    switch (preset) {
+        case JARRAY_INT_PRESET:
+        case JARRAY_LONG_PRESET:
+        case JARRAY_SHORT_PRESET:
+        case JARRAY_CHAR_PRESET:
+        case JARRAY_UINT_PRESET:
+        case JARRAY_ULONG_PRESET:
+        case JARRAY_USHORT_PRESET:
+        case JARRAY_FLOAT_PRESET:
+        case JARRAY_DOUBLE_PRESET:
+            return true;
+        default:
+            return false;
+    }
+}
+
+size_t jarray_format_value(JARRAY_TYPE_PRESET preset, const void *elem, char *out) {
+    switch (preset) {
+        case JARRAY_INT_PRESET:    return jarray_format_i64(out, JARRAY_GET_VALUE(const int, elem));
+        case JARRAY_LONG_PRESET:   return jarray_format_i64(out, JARRAY_GET_VALUE(const long, elem));
+        case JARRAY_SHORT_PRESET:  return jarray_format_i64(out, JARRAY_GET_VALUE(const short, elem));
+        case JARRAY_UINT_PRESET:   return jarray_format_u64(out, JARRAY_GET_VALUE(const unsigned int, elem));
+        case JARRAY_ULONG_PRESET:  return jarray_format_u64(out, JARRAY_GET_VALUE(const unsigned long, elem));
+        case JARRAY_USHORT_PRESET: return jarray_format_u64(out, JARRAY_GET_VALUE(const unsigned short, elem));
+        case JARRAY_FLOAT_PRESET:  return jarray_format_fixed2(out, JARRAY_GET_VALUE(const float, elem));
+        case JARRAY_DOUBLE_PRESET: return jarray_format_fixed2(out, JARRAY_GET_VALUE(const double, elem));
+        case JARRAY_CHAR_PRESET:
+            out[0] = JARRAY_GET_VALUE(const char, elem);
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+size_t jarray_format_into(JARRAY_TYPE_PRESET preset, const void *elem, char *buf, size_t cap) {
+    char text[JARRAY_FORMAT_MAX];
+    size_t length = jarray_format_value(preset, elem, text);
+    if (length < cap) {
+        memcpy(buf, text, length);
+        buf[length] = '\0';
+    }
+    return length;
+}
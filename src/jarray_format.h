@@ -0,0 +1,56 @@
+/**
+ * @file jarray_format.h
+ * @brief Internal text formatting of the numeric presets, used by the buffered print path. Not part of the public API.
+ */
+
+#ifndef JARRAY_FORMAT_H
+#define JARRAY_FORMAT_H
+
+#include "../inc/jarray.h"
+
+/// Room `jarray_format_value` may need for one element: `%.2f` of -DBL_MAX is 313 characters.
+#define JARRAY_FORMAT_MAX 320
+
+/**
+ * @brief Checks if `jarray_format_value` handles elements of this preset.
+ */
+bool jarray_format_supported(JARRAY_TYPE_PRESET preset);
+
+/**
+ * @brief Writes an unsigned integer in decimal, two digits per step. No terminator.
+ * @return number of characters written (at most 20).
+ */
+size_t jarray_format_u64(char *out, unsigned long long value);
+
+/**
+ * @brief Writes a signed integer in decimal. No terminator.
+ * @return number of characters written (at most 20).
+ */
+size_t jarray_format_i64(char *out, long long value);
+
+/**
+ * @brief Writes `value` with two decimals, the same text as `printf("%.2f")`. No terminator.
+ *
+ * @note Values below 2^31 are rounded in integer arithmetic. Larger values, non finite values
+ * and products too close to a rounding tie go through snprintf, so the text never differs.
+ *
+ * @param out Buffer of at least `JARRAY_FORMAT_MAX` bytes.
+ * @return number of characters written.
+ */
+size_t jarray_format_fixed2(char *out, double value);
+
+/**
+ * @brief Writes one element the way the preset prints it (`%d`, `%c`, `%.2f`, ...). No terminator.
+ *
+ * @param out Buffer of at least `JARRAY_FORMAT_MAX` bytes.
+ * @return number of characters written, 0 if the preset is not supported.
+ */
+size_t jarray_format_value(JARRAY_TYPE_PRESET preset, const void *elem, char *out);
+
+/**
+ * @brief `jarray_format_value` with snprintf semantics, for `element_format_callback` of the presets.
+ * @return length of the full text, nothing useful written if it is >= cap.
+ */
+size_t jarray_format_into(JARRAY_TYPE_PRESET preset, const void *elem, char *buf, size_t cap);
+
+#endif // JARRAY_FORMAT_H
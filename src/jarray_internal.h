@@ -0,0 +1,50 @@
+/**
+ * @file jarray_internal.h
+ * @brief Error reporting shared by the translation units of the JARRAY library. Not part of the public API.
+ */
+
+#ifndef JARRAY_INTERNAL_H
+#define JARRAY_INTERNAL_H
+
+#include "../inc/jarray.h"
+
+/**
+ * @brief Records an error in the calling thread's `last_error_trace`, like every JARRAY function on failure.
+ */
+void jarray_internal_error(const JARRAY *ret_source, JARRAY_ERROR error_code, const char *fmt, ...);
+
+/**
+ * @brief Clears the calling thread's `last_error_trace`, like every JARRAY function on success.
+ */
+void jarray_internal_reset_error(void);
+
+/**
+ * @brief Copies `count` elements laid out like `model`, deep copying pointers with its `copy_elem_callback`.
+ */
+void jarray_internal_copy_elems(JARRAY *model, void *dest, const void *src, size_t count);
+
+/**
+ * @brief Frees what the `count` elements of `data` point to if `model` stores pointers, nothing otherwise.
+ */
+void jarray_internal_free_elems(const JARRAY *model, void *data, size_t count);
+
+/**
+ * @brief Rebuilds a stale hash index or bloom filter now, detaching it if the rebuild fails.
+ * @note Lookups then only read the attachments, so they can run concurrently.
+ */
+void jarray_internal_refresh_attachments(JARRAY *self);
+
+/**
+ * @brief `is_equal_callback` of the numeric presets, compared against an array's callback to enable the vectorized scans.
+ */
+bool jarray_internal_is_equal_int(const void *x, const void *y);
+bool jarray_internal_is_equal_float(const void *x, const void *y);
+bool jarray_internal_is_equal_char(const void *x, const void *y);
+bool jarray_internal_is_equal_double(const void *x, const void *y);
+bool jarray_internal_is_equal_long(const void *x, const void *y);
+bool jarray_internal_is_equal_short(const void *x, const void *y);
+bool jarray_internal_is_equal_uint(const void *x, const void *y);
+bool jarray_internal_is_equal_ulong(const void *x, const void *y);
+bool jarray_internal_is_equal_ushort(const void *x, const void *y);
+
+#endif // JARRAY_INTERNAL_H
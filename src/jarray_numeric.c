@@ -0,0 +1,415 @@
+#include "jarray_numeric.h"
+#include "jarray_simd.h"
+#include <limits.h>
+#include <math.h>
+#include <string.h>
+
+/**
+ * @file jarray_numeric.c
+ * @brief Aggregation and element-wise kernels of the numeric presets.
+ *
+ * Kernels are plain loops written so the compiler vectorizes them (this file is built with -O3).
+ * On x86 every kernel is also compiled for AVX2, the variant being picked at runtime like the scan kernels of jarray_simd.c.
+ * Integer arithmetic wraps around (computed on unsigned types), integer sums and dot products use 64 bits unsigned
+ * accumulators (wrapping modulo 2^64), float sums are accumulated in double. Means use an accumulator that cannot wrap.
+ */
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__)) && defined(__SSE2__)
+#  define NUMERIC_X86
+#  define DISPATCH(base, NAME) (jarray_cpu_has_avx2() ? base##NAME##_avx2 : base##NAME##_default)
+#else
+#  define DISPATCH(base, NAME) base##NAME##_default
+#endif
+
+/// Name of a kernel in the variant being defined (NUMERIC_SUFFIX).
+#define KERNEL_NAME(base, NAME) KERNEL_NAME_(base, NAME, NUMERIC_SUFFIX)
+#define KERNEL_NAME_(base, NAME, SUFFIX) KERNEL_NAME__(base, NAME, SUFFIX)
+#define KERNEL_NAME__(base, NAME, SUFFIX) base##NAME##SUFFIX
+
+#define SUM_LANES 8     // independent accumulators: lets float sums vectorize without reassociating a single chain
+
+/// Accumulator of sums and dot products: unsigned for integers, so that they wrap instead of overflowing.
+#define SUM_ACC(IS_FLOAT) SUM_ACC_##IS_FLOAT
+#define SUM_ACC_0 unsigned long long
+#define SUM_ACC_1 double
+
+/// Accumulator of means: 128 bits integers (or long double) cannot wrap, whatever the length of the array.
+#if defined(__SIZEOF_INT128__)
+#  define MEAN_ACC_0 __extension__ __int128
+#else
+#  define MEAN_ACC_0 long double
+#endif
+#define MEAN_ACC(IS_FLOAT) MEAN_ACC_##IS_FLOAT
+#define MEAN_ACC_1 double
+
+/**
+ * X(PRESET, type, accumulator type, wrapping type, is float, lowest value, highest value)
+ * The wrapping type is the unsigned type used for integer arithmetic (at least `unsigned int` to avoid promotion to int).
+ */
+#define NUMERIC_TYPES(X) \
+    X(INT,    int,            long long,          unsigned int,   0, INT_MIN,   INT_MAX) \
+    X(LONG,   long,           long long,          unsigned long,  0, LONG_MIN,  LONG_MAX) \
+    X(SHORT,  short,          long long,          unsigned int,   0, SHRT_MIN,  SHRT_MAX) \
+    X(CHAR,   char,           long long,          unsigned int,   0, CHAR_MIN,  CHAR_MAX) \
+    X(UINT,   unsigned int,   unsigned long long, unsigned int,   0, 0,         UINT_MAX) \
+    X(ULONG,  unsigned long,  unsigned long long, unsigned long,  0, 0,         ULONG_MAX) \
+    X(USHORT, unsigned short, unsigned long long, unsigned int,   0, 0,         USHRT_MAX) \
+    X(FLOAT,  float,          double,             float,          1, -INFINITY, INFINITY) \
+    X(DOUBLE, double,         double,             double,         1, -INFINITY, INFINITY)
+
+#define DEFINE_KERNELS(NAME, T, ACC, WRAP, IS_FLOAT, LO, HI)                                             \
+    NUMERIC_KERNEL static ACC KERNEL_NAME(sum_, NAME)(const T *restrict x, size_t n) {                   \
+        SUM_ACC(IS_FLOAT) lanes[SUM_LANES] = {0};                                                        \
+        size_t i = 0;                                                                                    \
+        for (; i + SUM_LANES <= n; i += SUM_LANES)                                                       \
+            for (size_t l = 0; l < SUM_LANES; l++)                                                       \
+                lanes[l] += (SUM_ACC(IS_FLOAT))x[i + l];                                                 \
+        SUM_ACC(IS_FLOAT) total = 0;                                                                     \
+        for (size_t l = 0; l < SUM_LANES; l++)                                                           \
+            total += lanes[l];                                                                           \
+        for (; i < n; i++)                                                                               \
+            total += (SUM_ACC(IS_FLOAT))x[i];                                                            \
+        return (ACC)total;                                                                               \
+    }                                                                                                    \
+    NUMERIC_KERNEL static ACC KERNEL_NAME(dot_, NAME)(const T *restrict x, const T *restrict y, size_t n) { \
+        SUM_ACC(IS_FLOAT) lanes[SUM_LANES] = {0};                                                        \
+        size_t i = 0;                                                                                    \
+        for (; i + SUM_LANES <= n; i += SUM_LANES)                                                       \
+            for (size_t l = 0; l < SUM_LANES; l++)                                                       \
+                lanes[l] += (SUM_ACC(IS_FLOAT))x[i + l] * (SUM_ACC(IS_FLOAT))y[i + l];                   \
+        SUM_ACC(IS_FLOAT) total = 0;                                                                     \
+        for (size_t l = 0; l < SUM_LANES; l++)                                                           \
+            total += lanes[l];                                                                           \
+        for (; i < n; i++)                                                                               \
+            total += (SUM_ACC(IS_FLOAT))x[i] * (SUM_ACC(IS_FLOAT))y[i];                                  \
+        return (ACC)total;                                                                               \
+    }                                                                                                    \
+    NUMERIC_KERNEL static double KERNEL_NAME(mean_, NAME)(const T *restrict x, size_t n) {               \
+        MEAN_ACC(IS_FLOAT) lanes[SUM_LANES] = {0};                                                       \
+        size_t i = 0;                                                                                    \
+        for (; i + SUM_LANES <= n; i += SUM_LANES)                                                       \
+            for (size_t l = 0; l < SUM_LANES; l++)                                                       \
+                lanes[l] += x[i + l];                                                                    \
+        MEAN_ACC(IS_FLOAT) total = 0;                                                                    \
+        for (size_t l = 0; l < SUM_LANES; l++)                                                           \
+            total += lanes[l];                                                                           \
+        for (; i < n; i++)                                                                               \
+            total += x[i];                                                                               \
+        return (double)total / (double)n;                                                                \
+    }                                                                                                    \
+    /* Branch-free extremum value first (vectorizable), then the first index holding it */               \
+    NUMERIC_KERNEL static size_t KERNEL_NAME(arg_extremum_, NAME)(const T *restrict x, size_t n, bool max) { \
+        size_t first = 0;                                                                                \
+        if (IS_FLOAT)                                                                                    \
+            while (first < n && x[first] != x[first]) first++;                                           \
+        if (first == n) return 0;                                                                        \
+        T best = x[first];                                                                               \
+        if (max) {                                                                                       \
+            for (size_t i = first + 1; i < n; i++)                                                       \
+                best = x[i] > best ? x[i] : best;                                                        \
+        } else {                                                                                         \
+            for (size_t i = first + 1; i < n; i++)                                                       \
+                best = x[i] < best ? x[i] : best;                                                        \
+        }                                                                                                \
+        for (size_t i = first; i < n; i++)                                                               \
+            if (x[i] == best) return i;                                                                  \
+        return first;                                                                                    \
+    }                                                                                                    \
+    NUMERIC_KERNEL static void KERNEL_NAME(scale_, NAME)(T *restrict x, size_t n, T factor) {            \
+        for (size_t i = 0; i < n; i++)                                                                   \
+            x[i] = (T)((WRAP)x[i] * (WRAP)factor);                                                       \
+    }                                                                                                    \
+    NUMERIC_KERNEL static void KERNEL_NAME(axpy_, NAME)(T *restrict y, const T *restrict x, size_t n, T alpha) { \
+        for (size_t i = 0; i < n; i++)                                                                   \
+            y[i] = (T)((WRAP)y[i] + (WRAP)alpha * (WRAP)x[i]);                                           \
+    }                                                                                                    \
+    NUMERIC_KERNEL static void KERNEL_NAME(add_, NAME)(T *restrict y, const T *restrict x, size_t n) {   \
+        for (size_t i = 0; i < n; i++)                                                                   \
+            y[i] = (T)((WRAP)y[i] + (WRAP)x[i]);                                                         \
+    }                                                                                                    \
+    NUMERIC_KERNEL static void KERNEL_NAME(sub_, NAME)(T *restrict y, const T *restrict x, size_t n) {   \
+        for (size_t i = 0; i < n; i++)                                                                   \
+            y[i] = (T)((WRAP)y[i] - (WRAP)x[i]);                                                         \
+    }                                                                                                    \
+    NUMERIC_KERNEL static void KERNEL_NAME(mul_, NAME)(T *restrict y, const T *restrict x, size_t n) {   \
+        for (size_t i = 0; i < n; i++)                                                                   \
+            y[i] = (T)((WRAP)y[i] * (WRAP)x[i]);                                                         \
+    }                                                                                                    \
+    NUMERIC_KERNEL static void KERNEL_NAME(clamp_, NAME)(T *restrict x, size_t n, T lo, T hi) {          \
+        for (size_t i = 0; i < n; i++) {                                                                 \
+            T v = x[i] < lo ? lo : x[i];                                                                 \
+            x[i] = v > hi ? hi : v;                                                                      \
+        }                                                                                                \
+    }
+
+#define SCAN_OP_SUM(T, WRAP, a, b)  ((T)((WRAP)(a) + (WRAP)(b)))
+#define SCAN_OP_PROD(T, WRAP, a, b) ((T)((WRAP)(a) * (WRAP)(b)))
+#define SCAN_OP_MIN(T, WRAP, a, b)  ((b) < (a) ? (b) : (a))
+#define SCAN_OP_MAX(T, WRAP, a, b)  ((b) > (a) ? (b) : (a))
+
+/// X(type name, type, wrapping type, op name, op, identity of the op) for every built-in scan op
+#define SCAN_OPS(X, NAME, T, WRAP, LO, HI) \
+    X(NAME, T, WRAP, SUM,  SCAN_OP_SUM,  (T)0) \
+    X(NAME, T, WRAP, PROD, SCAN_OP_PROD, (T)1) \
+    X(NAME, T, WRAP, MIN,  SCAN_OP_MIN,  (T)(HI)) \
+    X(NAME, T, WRAP, MAX,  SCAN_OP_MAX,  (T)(LO))
+
+/**
+ * Scans blocks of 4 elements: the block prefix is computed without the carry (independent ops the compiler can
+ * pair or vectorize), so the loop-carried dependency is a single op per block instead of one per element.
+ * All the block is read before it is written, `dst` may be `src`.
+ */
+#define DEFINE_SCAN(NAME, T, WRAP, OPNAME, OP, IDENTITY)                                                 \
+    NUMERIC_KERNEL static void KERNEL_NAME(scan_##OPNAME##_, NAME)(T *dst, const T *src, size_t n, bool inclusive, T carry) { \
+        size_t i = 0;                                                                                    \
+        for (; i + 4 <= n; i += 4) {                                                                     \
+            T a0 = src[i], a1 = src[i + 1], a2 = src[i + 2], a3 = src[i + 3];                            \
+            T p1 = OP(T, WRAP, a0, a1);                                                                  \
+            T p2 = OP(T, WRAP, p1, a2);                                                                  \
+            T p3 = OP(T, WRAP, p1, OP(T, WRAP, a2, a3));                                                 \
+            if (inclusive) {                                                                             \
+                dst[i] = OP(T, WRAP, carry, a0);                                                         \
+                dst[i + 1] = OP(T, WRAP, carry, p1);                                                     \
+                dst[i + 2] = OP(T, WRAP, carry, p2);                                                     \
+                dst[i + 3] = OP(T, WRAP, carry, p3);                                                     \
+            } else {                                                                                     \
+                dst[i] = carry;                                                                          \
+                dst[i + 1] = OP(T, WRAP, carry, a0);                                                     \
+                dst[i + 2] = OP(T, WRAP, carry, p1);                                                     \
+                dst[i + 3] = OP(T, WRAP, carry, p2);                                                     \
+            }                                                                                            \
+            carry = OP(T, WRAP, carry, p3);                                                              \
+        }                                                                                                \
+        for (; i < n; i++) {                                                                             \
+            T value = src[i];                                                                            \
+            T next = OP(T, WRAP, carry, value);                                                          \
+            dst[i] = inclusive ? next : carry;                                                           \
+            carry = next;                                                                                \
+        }                                                                                                \
+    }                                                                                                    \
+    NUMERIC_KERNEL static T KERNEL_NAME(reduce_##OPNAME##_, NAME)(const T *restrict x, size_t n) {       \
+        T lanes[SUM_LANES];                                                                              \
+        for (size_t l = 0; l < SUM_LANES; l++)                                                           \
+            lanes[l] = IDENTITY;                                                                         \
+        size_t i = 0;                                                                                    \
+        for (; i + SUM_LANES <= n; i += SUM_LANES)                                                       \
+            for (size_t l = 0; l < SUM_LANES; l++)                                                       \
+                lanes[l] = OP(T, WRAP, lanes[l], x[i + l]);                                              \
+        T total = IDENTITY;                                                                              \
+        for (size_t l = 0; l < SUM_LANES; l++)                                                           \
+            total = OP(T, WRAP, total, lanes[l]);                                                        \
+        for (; i < n; i++)                                                                               \
+            total = OP(T, WRAP, total, x[i]);                                                            \
+        return total;                                                                                    \
+    }
+
+/**
+ * Counts every element into `lanes` interleaved sub-histograms (`counts[lane * bins + bin]`): consecutive equal values
+ * hit different counters, so increments do not wait on each other. The bin is a shift when width is a power of two.
+ */
+#define DEFINE_HISTOGRAM(NAME, T, ACC, WRAP, IS_FLOAT, LO, HI)                                                   \
+    NUMERIC_KERNEL static void KERNEL_NAME(histogram_, NAME)(const T *restrict x, size_t n, long long lo,        \
+                                                             size_t width, size_t bins, size_t lanes,            \
+                                                             size_t *restrict counts) {                          \
+        unsigned long long base = (unsigned long long)lo, span = (unsigned long long)width * bins;               \
+        if ((width & (width - 1)) == 0) {                                                                        \
+            unsigned shift = (unsigned)__builtin_ctzll(width);                                                   \
+            for (size_t i = 0; i < n; i++) {                                                                     \
+                unsigned long long offset = (unsigned long long)x[i] - base;                                     \
+                if (offset < span) counts[(i & (lanes - 1)) * bins + (size_t)(offset >> shift)]++;               \
+            }                                                                                                    \
+        } else {                                                                                                 \
+            for (size_t i = 0; i < n; i++) {                                                                     \
+                unsigned long long offset = (unsigned long long)x[i] - base;                                     \
+                if (offset < span) counts[(i & (lanes - 1)) * bins + (size_t)(offset / width)]++;                \
+            }                                                                                                    \
+        }                                                                                                        \
+    }
+
+#define DEFINE_SCANS(NAME, T, ACC, WRAP, IS_FLOAT, LO, HI) SCAN_OPS(DEFINE_SCAN, NAME, T, WRAP, LO, HI)
+
+#define NUMERIC_KERNEL
+#define NUMERIC_SUFFIX _default
+NUMERIC_TYPES(DEFINE_KERNELS)
+NUMERIC_TYPES(DEFINE_SCANS)
+NUMERIC_TYPES(DEFINE_HISTOGRAM)
+#undef NUMERIC_KERNEL
+#undef NUMERIC_SUFFIX
+
+#ifdef NUMERIC_X86
+#define NUMERIC_KERNEL __attribute__((target("avx2")))
+#define NUMERIC_SUFFIX _avx2
+NUMERIC_TYPES(DEFINE_KERNELS)
+NUMERIC_TYPES(DEFINE_SCANS)
+NUMERIC_TYPES(DEFINE_HISTOGRAM)
+#undef NUMERIC_KERNEL
+#undef NUMERIC_SUFFIX
+#endif
+
+bool jarray_numeric_supported(JARRAY_TYPE_PRESET preset) {
+    switch (preset) {
+#define SUPPORTED_CASE(NAME, T, ACC, WRAP, IS_FLOAT, LO, HI) case JARRAY_##NAME##_PRESET:
+        NUMERIC_TYPES(SUPPORTED_CASE)
+#undef SUPPORTED_CASE
+            return true;
+        default:
+            return false;
+    }
+}
+
+void jarray_numeric_sum(JARRAY_TYPE_PRESET preset, const void *data, size_t length, void *out) {
+    switch (preset) {
+#define SUM_CASE(NAME, T, ACC, WRAP, IS_FLOAT, LO, HI) \
+        case JARRAY_##NAME##_PRESET: { ACC total = DISPATCH(sum_, NAME)(data, length); memcpy(out, &total, sizeof(total)); return; }
+        NUMERIC_TYPES(SUM_CASE)
+#undef SUM_CASE
+        default: return;
+    }
+}
+
+double jarray_numeric_mean(JARRAY_TYPE_PRESET preset, const void *data, size_t length) {
+    switch (preset) {
+#define MEAN_CASE(NAME, T, ACC, WRAP, IS_FLOAT, LO, HI) \
+        case JARRAY_##NAME##_PRESET: return DISPATCH(mean_, NAME)(data, length);
+        NUMERIC_TYPES(MEAN_CASE)
+#undef MEAN_CASE
+        default: return 0.0;
+    }
+}
+
+void jarray_numeric_dot(JARRAY_TYPE_PRESET preset, const void *x, const void *y, size_t length, void *out) {
+    switch (preset) {
+#define DOT_CASE(NAME, T, ACC, WRAP, IS_FLOAT, LO, HI) \
+        case JARRAY_##NAME##_PRESET: { ACC total = DISPATCH(dot_, NAME)(x, y, length); memcpy(out, &total, sizeof(total)); return; }
+        NUMERIC_TYPES(DOT_CASE)
+#undef DOT_CASE
+        default: return;
+    }
+}
+
+size_t jarray_numeric_arg_extremum(JARRAY_TYPE_PRESET preset, const void *data, size_t length, bool max) {
+    switch (preset) {
+#define ARG_CASE(NAME, T, ACC, WRAP, IS_FLOAT, LO, HI) \
+        case JARRAY_##NAME##_PRESET: return DISPATCH(arg_extremum_, NAME)(data, length, max);
+        NUMERIC_TYPES(ARG_CASE)
+#undef ARG_CASE
+        default: return 0;
+    }
+}
+
+void jarray_numeric_scale(JARRAY_TYPE_PRESET preset, void *data, size_t length, const void *factor) {
+    switch (preset) {
+#define SCALE_CASE(NAME, T, ACC, WRAP, IS_FLOAT, LO, HI) \
+        case JARRAY_##NAME##_PRESET: { T f; memcpy(&f, factor, sizeof(f)); DISPATCH(scale_, NAME)(data, length, f); return; }
+        NUMERIC_TYPES(SCALE_CASE)
+#undef SCALE_CASE
+        default: return;
+    }
+}
+
+void jarray_numeric_axpy(JARRAY_TYPE_PRESET preset, void *y, const void *x, size_t length, const void *alpha) {
+    switch (preset) {
+#define AXPY_CASE(NAME, T, ACC, WRAP, IS_FLOAT, LO, HI) \
+        case JARRAY_##NAME##_PRESET: { T a; memcpy(&a, alpha, sizeof(a)); DISPATCH(axpy_, NAME)(y, x, length, a); return; }
+        NUMERIC_TYPES(AXPY_CASE)
+#undef AXPY_CASE
+        default: return;
+    }
+}
+
+void jarray_numeric_binary(JARRAY_TYPE_PRESET preset, JARRAY_NUMERIC_OP op, void *y, const void *x, size_t length) {
+    switch (preset) {
+#define BINARY_CASE(NAME, T, ACC, WRAP, IS_FLOAT, LO, HI)                   \
+        case JARRAY_##NAME##_PRESET:                                                                     \
+            if (op == JARRAY_NUMERIC_ADD) DISPATCH(add_, NAME)(y, x, length);                            \
+            else if (op == JARRAY_NUMERIC_SUB) DISPATCH(sub_, NAME)(y, x, length);                       \
+            else DISPATCH(mul_, NAME)(y, x, length);                                                     \
+            return;
+        NUMERIC_TYPES(BINARY_CASE)
+#undef BINARY_CASE
+        default: return;
+    }
+}
+
+void jarray_numeric_clamp(JARRAY_TYPE_PRESET preset, void *data, size_t length, const void *lo, const void *hi) {
+    switch (preset) {
+#define CLAMP_CASE(NAME, T, ACC, WRAP, IS_FLOAT, LO, HI) \
+        case JARRAY_##NAME##_PRESET: { T l, h; memcpy(&l, lo, sizeof(l)); memcpy(&h, hi, sizeof(h)); DISPATCH(clamp_, NAME)(data, length, l, h); return; }
+        NUMERIC_TYPES(CLAMP_CASE)
+#undef CLAMP_CASE
+        default: return;
+    }
+}
+
+#define SCAN_OP_CASE(NAME, T, WRAP, OPNAME, OP, IDENTITY) \
+                case JARRAY_SCAN_##OPNAME: DISPATCH(scan_##OPNAME##_, NAME)(dst, src, length, inclusive, carry_in ? carry : IDENTITY); return;
+
+void jarray_numeric_scan(JARRAY_TYPE_PRESET preset, JARRAY_SCAN_OP op, void *dst, const void *src, size_t length, bool inclusive, const void *carry_in) {
+    switch (preset) {
+#define SCAN_CASE(NAME, T, ACC, WRAP, IS_FLOAT, LO, HI)             \
+        case JARRAY_##NAME##_PRESET: {                                                                   \
+            T carry = 0;                                                                                 \
+            if (carry_in) memcpy(&carry, carry_in, sizeof(carry));                                       \
+            switch (op) {                                                                                \
+                SCAN_OPS(SCAN_OP_CASE, NAME, T, WRAP, LO, HI)                                            \
+                default: return;                                                                         \
+            }                                                                                            \
+        }
+        NUMERIC_TYPES(SCAN_CASE)
+#undef SCAN_CASE
+        default: return;
+    }
+}
+
+#define REDUCE_OP_CASE(NAME, T, WRAP, OPNAME, OP, IDENTITY) \
+                case JARRAY_SCAN_##OPNAME: { T total = DISPATCH(reduce_##OPNAME##_, NAME)(src, length); memcpy(out, &total, sizeof(total)); return; }
+
+void jarray_numeric_reduce(JARRAY_TYPE_PRESET preset, JARRAY_SCAN_OP op, const void *src, size_t length, void *out) {
+    switch (preset) {
+#define REDUCE_CASE(NAME, T, ACC, WRAP, IS_FLOAT, LO, HI)           \
+        case JARRAY_##NAME##_PRESET:                                                                     \
+            switch (op) {                                                                                \
+                SCAN_OPS(REDUCE_OP_CASE, NAME, T, WRAP, LO, HI)                                          \
+                default: return;                                                                         \
+            }
+        NUMERIC_TYPES(REDUCE_CASE)
+#undef REDUCE_CASE
+        default: return;
+    }
+}
+
+#define COMBINE_OP_CASE(NAME, T, WRAP, OPNAME, OP, IDENTITY) \
+                case JARRAY_SCAN_##OPNAME: a = OP(T, WRAP, a, b); break;
+
+void jarray_numeric_combine(JARRAY_TYPE_PRESET preset, JARRAY_SCAN_OP op, void *acc, const void *value) {
+    switch (preset) {
+#define COMBINE_CASE(NAME, T, ACC, WRAP, IS_FLOAT, LO, HI)          \
+        case JARRAY_##NAME##_PRESET: {                                                                   \
+            T a, b;                                                                                      \
+            memcpy(&a, acc, sizeof(a));                                                                  \
+            memcpy(&b, value, sizeof(b));                                                                \
+            switch (op) {                                                                                \
+                SCAN_OPS(COMBINE_OP_CASE, NAME, T, WRAP, LO, HI)                                         \
+                default: return;                                                                         \
+            }                                                                                            \
+            memcpy(acc, &a, sizeof(a));                                                                  \
+            return;                                                                                      \
+        }
+        NUMERIC_TYPES(COMBINE_CASE)
+#undef COMBINE_CASE
+        default: return;
+    }
+}
+
+void jarray_numeric_histogram(JARRAY_TYPE_PRESET preset, const void *data, size_t length, long long lo, size_t width, size_t bins, size_t lanes, size_t *counts) {
+    switch (preset) {
+#define HISTOGRAM_CASE(NAME, T, ACC, WRAP, IS_FLOAT, LO, HI)        \
+        case JARRAY_##NAME##_PRESET:                                \
+            if (IS_FLOAT) return;                                   \
+            DISPATCH(histogram_, NAME)(data, length, lo, width, bins, lanes, counts); \
+            return;
+        NUMERIC_TYPES(HISTOGRAM_CASE)
+#undef HISTOGRAM_CASE
+        default: return;
+    }
+}
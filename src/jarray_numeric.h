@@ -0,0 +1,87 @@
+/**
+ * @file jarray_numeric.h
+ * @brief Internal numeric kernels of the JARRAY library for the numeric presets. Not part of the public API.
+ */
+
+#ifndef JARRAY_NUMERIC_H
+#define JARRAY_NUMERIC_H
+
+#include "../inc/jarray.h"
+
+/// Element-wise operations between two arrays.
+typedef enum JARRAY_NUMERIC_OP {
+    JARRAY_NUMERIC_ADD,
+    JARRAY_NUMERIC_SUB,
+    JARRAY_NUMERIC_MUL,
+} JARRAY_NUMERIC_OP;
+
+/**
+ * @brief Checks if the kernels handle arrays of this preset.
+ */
+bool jarray_numeric_supported(JARRAY_TYPE_PRESET preset);
+
+/**
+ * @brief Sums `data[0..length)` into `out`: a `long long` for signed integers, `unsigned long long` for unsigned integers, a `double` for floats.
+ * Integer sums wrap around modulo 2^64 (computed unsigned): reachable with LONG and ULONG elements, which get no wider accumulator.
+ */
+void jarray_numeric_sum(JARRAY_TYPE_PRESET preset, const void *data, size_t length, void *out);
+
+/**
+ * @brief Mean of `data[0..length)`, `length` not 0. Integers are summed in 128 bits (long double without `__int128`), so the sum never wraps.
+ */
+double jarray_numeric_mean(JARRAY_TYPE_PRESET preset, const void *data, size_t length);
+
+/**
+ * @brief Dot product of `x` and `y` into `out` (same types as `jarray_numeric_sum`).
+ */
+void jarray_numeric_dot(JARRAY_TYPE_PRESET preset, const void *x, const void *y, size_t length, void *out);
+
+/**
+ * @brief Index of the first minimum (or maximum if `max`) of `data[0..length)`, NaN being ignored. `length` must not be 0.
+ */
+size_t jarray_numeric_arg_extremum(JARRAY_TYPE_PRESET preset, const void *data, size_t length, bool max);
+
+/**
+ * @brief `data[i] *= *factor`, `factor` pointing to an element of the preset type.
+ */
+void jarray_numeric_scale(JARRAY_TYPE_PRESET preset, void *data, size_t length, const void *factor);
+
+/**
+ * @brief `y[i] += *alpha * x[i]`, `alpha` pointing to an element of the preset type.
+ */
+void jarray_numeric_axpy(JARRAY_TYPE_PRESET preset, void *y, const void *x, size_t length, const void *alpha);
+
+/**
+ * @brief `y[i] = y[i] op x[i]`.
+ */
+void jarray_numeric_binary(JARRAY_TYPE_PRESET preset, JARRAY_NUMERIC_OP op, void *y, const void *x, size_t length);
+
+/**
+ * @brief Clamps every element into `[*lo, *hi]`, bounds pointing to elements of the preset type.
+ */
+void jarray_numeric_clamp(JARRAY_TYPE_PRESET preset, void *data, size_t length, const void *lo, const void *hi);
+
+/**
+ * @brief Scans `src[0..length)` into `dst` (which may be `src`) with a built-in op, starting from `*carry_in`
+ * (an element of the preset type) or from the identity of the op if NULL.
+ */
+void jarray_numeric_scan(JARRAY_TYPE_PRESET preset, JARRAY_SCAN_OP op, void *dst, const void *src, size_t length, bool inclusive, const void *carry_in);
+
+/**
+ * @brief Reduces `src[0..length)` with a built-in op into `out`, an element of the preset type (identity of the op if empty).
+ */
+void jarray_numeric_reduce(JARRAY_TYPE_PRESET preset, JARRAY_SCAN_OP op, const void *src, size_t length, void *out);
+
+/**
+ * @brief `*acc = *acc op *value`, both elements of the preset type.
+ */
+void jarray_numeric_combine(JARRAY_TYPE_PRESET preset, JARRAY_SCAN_OP op, void *acc, const void *value);
+
+/**
+ * @brief Adds every integer element of `data[0..length)` within `[lo, lo + width * bins)` to the counter of its bin.
+ * `counts` holds `lanes` interleaved sub-histograms of `bins` counters, element i going to sub-histogram `i % lanes` (lanes is a power of two).
+ * Does nothing for float presets.
+ */
+void jarray_numeric_histogram(JARRAY_TYPE_PRESET preset, const void *data, size_t length, long long lo, size_t width, size_t bins, size_t lanes, size_t *counts);
+
+#endif // JARRAY_NUMERIC_H
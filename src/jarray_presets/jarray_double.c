@@ -1,4 +1,6 @@
 #include "../../inc/jarray.h"
+#include "../jarray_internal.h"
+#include "../jarray_format.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
@@ -17,24 +19,38 @@ static char *element_to_string_array_callback(const void *x){
     return str;
 }
 
+static size_t element_format_array_callback(const void *x, char *buf, size_t cap){
+    return jarray_format_into(JARRAY_DOUBLE_PRESET, x, buf, cap);
+}
+
 static int compare_array_callback(const void *x, const void *y){
     return JARRAY_GET_VALUE(const double, x) - JARRAY_GET_VALUE(const double, y);
 }
 
-static bool is_equal_array_callback(const void *x, const void *y){
+bool jarray_internal_is_equal_double(const void *x, const void *y){
     const double x_d = JARRAY_GET_VALUE(const double, x);
     const double y_d = JARRAY_GET_VALUE(const double, y);
     return x_d == y_d;
 }
 
+static size_t hash_array_callback(const void *x){
+    double value = JARRAY_GET_VALUE(const double, x);
+    if (value == 0.0) value = 0.0; // -0.0 and 0.0 are equal, they must share the same hash
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return jarray_hash_u64(bits);
+}
+
 
 JARRAY create_jarray_double(void){
     JARRAY array;
-    JARRAY_USER_CALLBACK_IMPLEMENTATION imp;
+    JARRAY_USER_CALLBACK_IMPLEMENTATION imp = {0};
     imp.print_element_callback = print_element_array_callback;
     imp.element_to_string_callback = element_to_string_array_callback;
+    imp.element_format_callback = element_format_array_callback;
     imp.compare_callback = compare_array_callback;
-    imp.is_equal_callback = is_equal_array_callback;
+    imp.is_equal_callback = jarray_internal_is_equal_double;
+    imp.hash_callback = hash_array_callback;
     jarray.init(&array, sizeof(double), JARRAY_TYPE_VALUE, imp);
     array._type_preset = JARRAY_DOUBLE_PRESET;
     return array;
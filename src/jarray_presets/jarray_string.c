@@ -19,6 +19,13 @@ static char *element_to_string_array_callback(const void *x){
     return my_strdup(*str);
 }
 
+static size_t element_format_array_callback(const void *x, char *buf, size_t cap){
+    const char *str = *(char**)x;
+    size_t len = strlen(str);
+    if (len < cap) memcpy(buf, str, len + 1);
+    return len;
+}
+
 static int compare_array_callback(const void *x, const void *y){
     return strcmp(*(char**)x, *(char**)y);
 }
@@ -39,15 +46,22 @@ static void *copy_elem_override(const void *x){
     return res;
 }
 
+static size_t hash_array_callback(const void *x){
+    const char *str = *(char**)x;
+    return jarray_hash_bytes(str, strlen(str));
+}
+
 
 JARRAY create_jarray_string(void){
 
     JARRAY array;
-    JARRAY_USER_CALLBACK_IMPLEMENTATION imp;
+    JARRAY_USER_CALLBACK_IMPLEMENTATION imp = {0};
     imp.print_element_callback = print_element_array_callback;
     imp.element_to_string_callback = element_to_string_array_callback;
+    imp.element_format_callback = element_format_array_callback;
     imp.compare_callback = compare_array_callback;
     imp.is_equal_callback = is_equal_array_callback;
+    imp.hash_callback = hash_array_callback;
     imp.copy_elem_callback = copy_elem_override;
     jarray.init(&array, sizeof(char*), JARRAY_TYPE_POINTER, imp);
     array._type_preset = JARRAY_STRING_PRESET;
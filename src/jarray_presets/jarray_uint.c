@@ -1,4 +1,6 @@
 #include "../../inc/jarray.h"
+#include "../jarray_internal.h"
+#include "../jarray_format.h"
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -16,22 +18,32 @@ static char *element_to_string_array_callback(const void *x){
     return str;
 }
 
+static size_t element_format_array_callback(const void *x, char *buf, size_t cap){
+    return jarray_format_into(JARRAY_UINT_PRESET, x, buf, cap);
+}
+
 static int compare_array_callback(const void *x, const void *y){
     return JARRAY_GET_VALUE(const unsigned int, x) - JARRAY_GET_VALUE(const unsigned int, y);
 }
 
-static bool is_equal_array_callback(const void *x, const void *y){
+bool jarray_internal_is_equal_uint(const void *x, const void *y){
     return JARRAY_GET_VALUE(const unsigned int, x) == JARRAY_GET_VALUE(const unsigned int, y);
 }
 
+static size_t hash_array_callback(const void *x){
+    return jarray_hash_u64((uint64_t)JARRAY_GET_VALUE(const unsigned int, x));
+}
+
 
 JARRAY create_jarray_uint(void){
     JARRAY array;
-    JARRAY_USER_CALLBACK_IMPLEMENTATION imp;
+    JARRAY_USER_CALLBACK_IMPLEMENTATION imp = {0};
     imp.print_element_callback = print_element_array_callback;
     imp.element_to_string_callback = element_to_string_array_callback;
+    imp.element_format_callback = element_format_array_callback;
     imp.compare_callback = compare_array_callback;
-    imp.is_equal_callback = is_equal_array_callback;
+    imp.is_equal_callback = jarray_internal_is_equal_uint;
+    imp.hash_callback = hash_array_callback;
     jarray.init(&array, sizeof(unsigned int), JARRAY_TYPE_VALUE, imp);
     array._type_preset = JARRAY_UINT_PRESET;
     return array;
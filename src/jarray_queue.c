@@ -0,0 +1,284 @@
+#include "../inc/jarray_queue.h"
+#include "jarray_internal.h"
+#include <stdatomic.h>
+#include <stdint.h>
+
+/**
+ * @file jarray_queue.c
+ * @brief Bounded ring buffers: SPSC with cached counters, MPMC with one sequence number per slot (Vyukov).
+ */
+
+#define QUEUE_CACHE_LINE 64
+#define QUEUE_MIN_CAPACITY 2
+
+/*
+ * Positions only grow, the slot of a position is `position & mask`.
+ * `tail` is the next position to push, `head` the next to pop, each on its own cache line with the copy of the
+ * other counter its side last read (SPSC only): the producer rereads `head` only when the queue looks full,
+ * the consumer rereads `tail` only when it looks empty.
+ * MPMC: slot `p & mask` has sequence `p` when free for the push at position `p`, `p + 1` once that element is
+ * written, and `p + capacity` once it is popped (free for the next lap).
+ */
+struct JARRAY_QUEUE {
+    JARRAY model;                   // element size, type and callbacks, holds no data
+    JARRAY_QUEUE_MODE mode;
+    size_t mask;
+    unsigned char *data;
+    atomic_size_t *sequences;       // MPMC only
+    _Alignas(QUEUE_CACHE_LINE) atomic_size_t tail;
+    size_t cached_head;
+    _Alignas(QUEUE_CACHE_LINE) atomic_size_t head;
+    size_t cached_tail;
+};
+
+static bool check_queue(const JARRAY_QUEUE *queue, const char *action) {
+    if (!queue) {
+        jarray_internal_error(NULL, JARRAY_INVALID_ARGUMENT, "Cannot %s a NULL JARRAY_QUEUE", action);
+        return false;
+    }
+    return true;
+}
+
+static inline size_t queue_capacity(const JARRAY_QUEUE *queue) {
+    return queue->mask + 1;
+}
+
+static inline unsigned char *slot_at(const JARRAY_QUEUE *queue, size_t position) {
+    return queue->data + (position & queue->mask) * queue->model._elem_size;
+}
+
+/// Number of slots from `position` to the end of the buffer, at most `count`: the first piece of a wrapping range.
+static inline size_t first_piece(const JARRAY_QUEUE *queue, size_t position, size_t count) {
+    size_t to_end = queue_capacity(queue) - (position & queue->mask);
+    return count < to_end ? count : to_end;
+}
+
+static void copy_in(JARRAY_QUEUE *queue, size_t position, const unsigned char *src, size_t count) {
+    size_t first = first_piece(queue, position, count);
+    jarray_internal_copy_elems(&queue->model, slot_at(queue, position), src, first);
+    if (first < count)
+        jarray_internal_copy_elems(&queue->model, queue->data, src + first * queue->model._elem_size, count - first);
+}
+
+/// Elements are moved out: what pointer elements point to now belongs to the caller.
+static void move_out(const JARRAY_QUEUE *queue, size_t position, unsigned char *dest, size_t count) {
+    size_t first = first_piece(queue, position, count);
+    memcpy(dest, slot_at(queue, position), first * queue->model._elem_size);
+    if (first < count)
+        memcpy(dest + first * queue->model._elem_size, queue->data, (count - first) * queue->model._elem_size);
+}
+
+static JARRAY_QUEUE *queue_create(size_t elem_size, JARRAY_DATA_TYPE data_type, JARRAY_USER_CALLBACK_IMPLEMENTATION user_callbacks, size_t capacity, JARRAY_QUEUE_MODE mode) {
+    if (elem_size == 0) {
+        jarray_internal_error(NULL, JARRAY_INVALID_ARGUMENT, "Element size of a JARRAY_QUEUE cannot be 0");
+        return NULL;
+    }
+    if (mode != JARRAY_QUEUE_SPSC && mode != JARRAY_QUEUE_MPMC) {
+        jarray_internal_error(NULL, JARRAY_INVALID_ARGUMENT, "Unknown JARRAY_QUEUE mode %d", (int)mode);
+        return NULL;
+    }
+    size_t rounded = QUEUE_MIN_CAPACITY;
+    while (rounded < capacity && rounded <= SIZE_MAX / 2) rounded <<= 1;
+    if (capacity == 0 || rounded < capacity || rounded > SIZE_MAX / elem_size) {
+        jarray_internal_error(NULL, JARRAY_INVALID_ARGUMENT, "Invalid JARRAY_QUEUE capacity %zu", capacity);
+        return NULL;
+    }
+
+    JARRAY_QUEUE *queue = aligned_alloc(QUEUE_CACHE_LINE, sizeof(JARRAY_QUEUE));
+    if (!queue) {
+        jarray_internal_error(NULL, JARRAY_DATA_NULL, "Memory allocation failed for JARRAY_QUEUE");
+        return NULL;
+    }
+    jarray.init(&queue->model, elem_size, data_type, user_callbacks);
+    if (last_error_trace.has_error) {
+        free(queue);
+        return NULL;
+    }
+    queue->mode = mode;
+    queue->mask = rounded - 1;
+    queue->data = malloc(rounded * elem_size);
+    queue->sequences = mode == JARRAY_QUEUE_MPMC ? malloc(rounded * sizeof(atomic_size_t)) : NULL;
+    if (!queue->data || (mode == JARRAY_QUEUE_MPMC && !queue->sequences)) {
+        free(queue->data);
+        free(queue->sequences);
+        free(queue);
+        jarray_internal_error(NULL, JARRAY_DATA_NULL, "Memory allocation failed for JARRAY_QUEUE buffer");
+        return NULL;
+    }
+    if (queue->sequences) {
+        for (size_t i = 0; i < rounded; i++)
+            atomic_init(&queue->sequences[i], i);
+    }
+    atomic_init(&queue->tail, 0);
+    atomic_init(&queue->head, 0);
+    queue->cached_head = 0;
+    queue->cached_tail = 0;
+    jarray_internal_reset_error();
+    return queue;
+}
+
+static JARRAY_QUEUE *queue_create_preset(JARRAY_TYPE_PRESET preset, size_t capacity, JARRAY_QUEUE_MODE mode) {
+    JARRAY model = jarray.init_preset(preset);
+    if (last_error_trace.has_error) return NULL;
+    JARRAY_QUEUE *queue = queue_create(model._elem_size, model._data_type, model.user_callbacks, capacity, mode);
+    if (queue) queue->model._type_preset = model._type_preset;
+    jarray.free(&model);
+    if (queue) jarray_internal_reset_error();
+    return queue;
+}
+
+static void queue_free(JARRAY_QUEUE *queue) {
+    if (!queue) return;
+    size_t head = atomic_load(&queue->head);
+    size_t count = atomic_load(&queue->tail) - head;
+    size_t first = first_piece(queue, head, count);
+    jarray_internal_free_elems(&queue->model, slot_at(queue, head), first);
+    jarray_internal_free_elems(&queue->model, queue->data, count - first);
+    jarray.free(&queue->model);
+    free(queue->data);
+    free(queue->sequences);
+    free(queue);
+}
+
+static size_t spsc_push_n(JARRAY_QUEUE *queue, const unsigned char *elems, size_t count) {
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    size_t room = queue_capacity(queue) - (tail - queue->cached_head);
+    if (room < count) {
+        queue->cached_head = atomic_load_explicit(&queue->head, memory_order_acquire);
+        room = queue_capacity(queue) - (tail - queue->cached_head);
+        if (room < count) count = room;
+    }
+    if (count == 0) return 0;
+    copy_in(queue, tail, elems, count);
+    atomic_store_explicit(&queue->tail, tail + count, memory_order_release);
+    return count;
+}
+
+static size_t spsc_pop_n(JARRAY_QUEUE *queue, unsigned char *out, size_t max) {
+    size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    size_t available = queue->cached_tail - head;
+    if (available < max) {
+        queue->cached_tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+        available = queue->cached_tail - head;
+        if (available < max) max = available;
+    }
+    if (max == 0) return 0;
+    move_out(queue, head, out, max);
+    atomic_store_explicit(&queue->head, head + max, memory_order_release);
+    return max;
+}
+
+/*
+ * Claims the run of slots from `*counter` whose sequence is `position + offset`, up to `count` slots, by moving
+ * the counter past them. Returns the number of claimed slots, their first position in `*claimed`.
+ * A slot still holding the previous lap (sequence behind) means full for pushes, empty for pops.
+ */
+static size_t mpmc_claim(JARRAY_QUEUE *queue, atomic_size_t *counter, size_t offset, size_t count, size_t *claimed) {
+    size_t position = atomic_load_explicit(counter, memory_order_relaxed);
+    for (;;) {
+        size_t run = 0;
+        intptr_t diff = 0;
+        for (; run < count; run++) {
+            size_t sequence = atomic_load_explicit(&queue->sequences[(position + run) & queue->mask], memory_order_acquire);
+            diff = (intptr_t)(sequence - (position + run + offset));
+            if (diff != 0) break;
+        }
+        if (run > 0) {
+            if (atomic_compare_exchange_weak_explicit(counter, &position, position + run, memory_order_relaxed, memory_order_relaxed)) {
+                *claimed = position;
+                return run;
+            }
+        } else if (diff < 0) {
+            return 0;
+        } else {
+            // Another thread claimed this slot first
+            position = atomic_load_explicit(counter, memory_order_relaxed);
+        }
+    }
+}
+
+static size_t mpmc_push_n(JARRAY_QUEUE *queue, const unsigned char *elems, size_t count) {
+    size_t position;
+    count = mpmc_claim(queue, &queue->tail, 0, count, &position);
+    if (count == 0) return 0;
+    copy_in(queue, position, elems, count);
+    for (size_t i = 0; i < count; i++)
+        atomic_store_explicit(&queue->sequences[(position + i) & queue->mask], position + i + 1, memory_order_release);
+    return count;
+}
+
+static size_t mpmc_pop_n(JARRAY_QUEUE *queue, unsigned char *out, size_t max) {
+    size_t position;
+    max = mpmc_claim(queue, &queue->head, 1, max, &position);
+    if (max == 0) return 0;
+    move_out(queue, position, out, max);
+    for (size_t i = 0; i < max; i++)
+        atomic_store_explicit(&queue->sequences[(position + i) & queue->mask], position + i + queue_capacity(queue), memory_order_release);
+    return max;
+}
+
+static size_t queue_push_n(JARRAY_QUEUE *queue, const void *elems, size_t count) {
+    if (!check_queue(queue, "push to")) return 0;
+    if (!elems) {
+        jarray_internal_error(NULL, JARRAY_INVALID_ARGUMENT, "Elements to push are NULL");
+        return 0;
+    }
+    if (count == 0) {
+        jarray_internal_reset_error();
+        return 0;
+    }
+    size_t pushed = queue->mode == JARRAY_QUEUE_SPSC ? spsc_push_n(queue, elems, count) : mpmc_push_n(queue, elems, count);
+    // A full queue is not an error: only a successful push clears the trace
+    if (pushed > 0) jarray_internal_reset_error();
+    return pushed;
+}
+
+static size_t queue_pop_n(JARRAY_QUEUE *queue, void *out, size_t max) {
+    if (!check_queue(queue, "pop from")) return 0;
+    if (!out) {
+        jarray_internal_error(NULL, JARRAY_INVALID_ARGUMENT, "Output buffer is NULL");
+        return 0;
+    }
+    if (max == 0) {
+        jarray_internal_reset_error();
+        return 0;
+    }
+    size_t popped = queue->mode == JARRAY_QUEUE_SPSC ? spsc_pop_n(queue, out, max) : mpmc_pop_n(queue, out, max);
+    if (popped > 0) jarray_internal_reset_error();
+    return popped;
+}
+
+static bool queue_push(JARRAY_QUEUE *queue, const void *elem) {
+    return queue_push_n(queue, elem, 1) == 1;
+}
+
+static bool queue_pop(JARRAY_QUEUE *queue, void *out) {
+    return queue_pop_n(queue, out, 1) == 1;
+}
+
+static size_t queue_length(const JARRAY_QUEUE *queue) {
+    if (!check_queue(queue, "get the length of")) return 0;
+    // Head first: it never passes the tail read after it
+    size_t head = atomic_load_explicit(&queue->head, memory_order_acquire);
+    size_t length = atomic_load_explicit(&queue->tail, memory_order_acquire) - head;
+    jarray_internal_reset_error();
+    return length < queue_capacity(queue) ? length : queue_capacity(queue);
+}
+
+static size_t queue_get_capacity(const JARRAY_QUEUE *queue) {
+    if (!check_queue(queue, "get the capacity of")) return 0;
+    jarray_internal_reset_error();
+    return queue_capacity(queue);
+}
+
+JARRAY_QUEUE_INTERFACE jarray_queue = {
+    .create = queue_create,
+    .create_preset = queue_create_preset,
+    .free = queue_free,
+    .push = queue_push,
+    .pop = queue_pop,
+    .push_n = queue_push_n,
+    .pop_n = queue_pop_n,
+    .length = queue_length,
+    .capacity = queue_get_capacity,
+};
@@ -0,0 +1,306 @@
+#include "../inc/jarray_shared.h"
+#include "jarray_internal.h"
+#include <pthread.h>
+
+/**
+ * @file jarray_shared.c
+ * @brief JARRAY behind a reader-writer lock, optionally striped over index ranges for element reads and writes.
+ */
+
+/// Consecutive indexes sharing a stripe, so neighbouring elements of a stripe share cache lines rather than locks.
+#define SHARED_STRIPE_SPAN 64
+
+/*
+ * `structure` guards the layout of the array (length, capacity, data pointer, attachments).
+ * `get` and `set` hold it shared and lock the stripe of their index: shared to read, exclusive to write.
+ * Whole array reads hold it shared and every stripe shared, structural writes hold it exclusive.
+ * Locks are always taken structure first, then stripes in ascending order.
+ */
+struct JARRAY_SHARED {
+    JARRAY array;
+    pthread_rwlock_t structure;
+    pthread_rwlock_t *stripes;
+    size_t stripe_count;
+};
+
+static bool check_shared(const JARRAY_SHARED *shared, const char *action) {
+    if (!shared) {
+        jarray_internal_error(NULL, JARRAY_INVALID_ARGUMENT, "Cannot %s a NULL JARRAY_SHARED", action);
+        return false;
+    }
+    return true;
+}
+
+static inline pthread_rwlock_t *stripe_of(JARRAY_SHARED *shared, size_t index) {
+    return &shared->stripes[(index / SHARED_STRIPE_SPAN) % shared->stripe_count];
+}
+
+static void lock_read(JARRAY_SHARED *shared) {
+    pthread_rwlock_rdlock(&shared->structure);
+    for (size_t i = 0; i < shared->stripe_count; i++)
+        pthread_rwlock_rdlock(&shared->stripes[i]);
+}
+
+static void unlock_read(JARRAY_SHARED *shared) {
+    for (size_t i = shared->stripe_count; i > 0; i--)
+        pthread_rwlock_unlock(&shared->stripes[i - 1]);
+    pthread_rwlock_unlock(&shared->structure);
+}
+
+static bool try_lock_read(JARRAY_SHARED *shared) {
+    if (pthread_rwlock_tryrdlock(&shared->structure) != 0) return false;
+    for (size_t i = 0; i < shared->stripe_count; i++) {
+        if (pthread_rwlock_tryrdlock(&shared->stripes[i]) != 0) {
+            while (i > 0) pthread_rwlock_unlock(&shared->stripes[--i]);
+            pthread_rwlock_unlock(&shared->structure);
+            return false;
+        }
+    }
+    return true;
+}
+
+static void lock_write(JARRAY_SHARED *shared) {
+    pthread_rwlock_wrlock(&shared->structure);
+}
+
+/// Releases an exclusive lock. Stale attachments are rebuilt first, so that lookups under a shared lock only read them.
+static void unlock_write(JARRAY_SHARED *shared) {
+    jarray_internal_refresh_attachments(&shared->array);
+    pthread_rwlock_unlock(&shared->structure);
+}
+
+static JARRAY_SHARED *shared_create(JARRAY array, size_t stripes) {
+    JARRAY_SHARED *shared = calloc(1, sizeof(JARRAY_SHARED));
+    if (!shared) {
+        jarray_internal_error(NULL, JARRAY_DATA_NULL, "Memory allocation failed for JARRAY_SHARED");
+        return NULL;
+    }
+    if (stripes > 1) {
+        shared->stripes = malloc(stripes * sizeof(pthread_rwlock_t));
+        if (!shared->stripes) {
+            free(shared);
+            jarray_internal_error(NULL, JARRAY_DATA_NULL, "Memory allocation failed for JARRAY_SHARED stripes");
+            return NULL;
+        }
+    }
+    if (pthread_rwlock_init(&shared->structure, NULL) != 0) {
+        free(shared->stripes);
+        free(shared);
+        jarray_internal_error(NULL, JARRAY_DATA_NULL, "Lock initialization failed for JARRAY_SHARED");
+        return NULL;
+    }
+    for (; shared->stripe_count < stripes && shared->stripes; shared->stripe_count++) {
+        if (pthread_rwlock_init(&shared->stripes[shared->stripe_count], NULL) != 0) {
+            while (shared->stripe_count > 0) pthread_rwlock_destroy(&shared->stripes[--shared->stripe_count]);
+            pthread_rwlock_destroy(&shared->structure);
+            free(shared->stripes);
+            free(shared);
+            jarray_internal_error(NULL, JARRAY_DATA_NULL, "Lock initialization failed for JARRAY_SHARED stripes");
+            return NULL;
+        }
+    }
+    shared->array = array;
+    jarray_internal_refresh_attachments(&shared->array);
+    jarray_internal_reset_error();
+    return shared;
+}
+
+static void shared_free(JARRAY_SHARED *shared) {
+    if (!shared) return;
+    jarray.free(&shared->array);
+    for (size_t i = 0; i < shared->stripe_count; i++)
+        pthread_rwlock_destroy(&shared->stripes[i]);
+    pthread_rwlock_destroy(&shared->structure);
+    free(shared->stripes);
+    free(shared);
+}
+
+static void shared_read(JARRAY_SHARED *shared, void (*fn)(JARRAY *array, void *ctx), void *ctx) {
+    if (!check_shared(shared, "read")) return;
+    if (!fn)
+        return jarray_internal_error(NULL, JARRAY_INVALID_ARGUMENT, "Callback function is NULL");
+    lock_read(shared);
+    fn(&shared->array, ctx);
+    unlock_read(shared);
+}
+
+static void shared_write(JARRAY_SHARED *shared, void (*fn)(JARRAY *array, void *ctx), void *ctx) {
+    if (!check_shared(shared, "write")) return;
+    if (!fn)
+        return jarray_internal_error(NULL, JARRAY_INVALID_ARGUMENT, "Callback function is NULL");
+    lock_write(shared);
+    fn(&shared->array, ctx);
+    unlock_write(shared);
+}
+
+static bool shared_try_read(JARRAY_SHARED *shared, void (*fn)(JARRAY *array, void *ctx), void *ctx) {
+    if (!check_shared(shared, "read")) return false;
+    if (!fn) {
+        jarray_internal_error(NULL, JARRAY_INVALID_ARGUMENT, "Callback function is NULL");
+        return false;
+    }
+    // A busy lock is not an error: the trace is left as it was
+    if (!try_lock_read(shared)) return false;
+    fn(&shared->array, ctx);
+    unlock_read(shared);
+    return true;
+}
+
+static bool shared_try_write(JARRAY_SHARED *shared, void (*fn)(JARRAY *array, void *ctx), void *ctx) {
+    if (!check_shared(shared, "write")) return false;
+    if (!fn) {
+        jarray_internal_error(NULL, JARRAY_INVALID_ARGUMENT, "Callback function is NULL");
+        return false;
+    }
+    if (pthread_rwlock_trywrlock(&shared->structure) != 0) return false;
+    fn(&shared->array, ctx);
+    unlock_write(shared);
+    return true;
+}
+
+static size_t shared_length(JARRAY_SHARED *shared) {
+    if (!check_shared(shared, "get the length of")) return 0;
+    pthread_rwlock_rdlock(&shared->structure);
+    size_t length = shared->array._length;
+    pthread_rwlock_unlock(&shared->structure);
+    jarray_internal_reset_error();
+    return length;
+}
+
+static bool shared_get(JARRAY_SHARED *shared, size_t index, void *out) {
+    if (!check_shared(shared, "access")) return false;
+    if (!out) {
+        jarray_internal_error(NULL, JARRAY_INVALID_ARGUMENT, "Output buffer is NULL");
+        return false;
+    }
+    pthread_rwlock_rdlock(&shared->structure);
+    pthread_rwlock_t *stripe = shared->stripe_count > 1 ? stripe_of(shared, index) : NULL;
+    if (stripe) pthread_rwlock_rdlock(stripe);
+    void *elem = jarray.at(&shared->array, index);
+    if (elem) jarray_internal_copy_elems(&shared->array, out, elem, 1);
+    if (stripe) pthread_rwlock_unlock(stripe);
+    pthread_rwlock_unlock(&shared->structure);
+    return elem != NULL;
+}
+
+static bool shared_contains(JARRAY_SHARED *shared, const void *elem) {
+    if (!check_shared(shared, "search in")) return false;
+    lock_read(shared);
+    bool found = jarray.contains(&shared->array, elem);
+    unlock_read(shared);
+    return found;
+}
+
+static size_t shared_index_of(JARRAY_SHARED *shared, const void *elem) {
+    if (!check_shared(shared, "search in")) return SIZE_MAX;
+    lock_read(shared);
+    size_t index = jarray.index_of(&shared->array, elem);
+    unlock_read(shared);
+    return index;
+}
+
+static bool shared_find_first(JARRAY_SHARED *shared, bool (*predicate)(const void *elem, const void *ctx), const void *ctx, void *out) {
+    if (!check_shared(shared, "search in")) return false;
+    if (!out) {
+        jarray_internal_error(NULL, JARRAY_INVALID_ARGUMENT, "Output buffer is NULL");
+        return false;
+    }
+    lock_read(shared);
+    void *elem = jarray.find_first(&shared->array, predicate, ctx);
+    if (elem) jarray_internal_copy_elems(&shared->array, out, elem, 1);
+    unlock_read(shared);
+    return elem != NULL;
+}
+
+static void *shared_reduce(JARRAY_SHARED *shared, void* (*reducer)(const void* accumulator, const void* elem, const void* ctx), const void* initial_value, const void* ctx) {
+    if (!check_shared(shared, "reduce")) return NULL;
+    lock_read(shared);
+    void *result = jarray.reduce(&shared->array, reducer, initial_value, ctx);
+    unlock_read(shared);
+    return result;
+}
+
+static char *shared_join(JARRAY_SHARED *shared, const char *separator) {
+    if (!check_shared(shared, "join")) return NULL;
+    lock_read(shared);
+    char *result = jarray.join(&shared->array, separator);
+    unlock_read(shared);
+    return result;
+}
+
+static JARRAY shared_snapshot(JARRAY_SHARED *shared) {
+    JARRAY result = {0};
+    if (!check_shared(shared, "copy")) return result;
+    lock_read(shared);
+    result = jarray.clone(&shared->array);
+    unlock_read(shared);
+    return result;
+}
+
+static void shared_add(JARRAY_SHARED *shared, const void *elem) {
+    if (!check_shared(shared, "add to")) return;
+    lock_write(shared);
+    jarray.add(&shared->array, elem);
+    unlock_write(shared);
+}
+
+static void shared_set(JARRAY_SHARED *shared, size_t index, const void *elem) {
+    if (!check_shared(shared, "set in")) return;
+    pthread_rwlock_rdlock(&shared->structure);
+    // Attachments are shared by the whole array: keeping them in sync needs the exclusive lock
+    if (shared->stripe_count > 1 && !shared->array._hash_index && !shared->array._bloom_filter) {
+        pthread_rwlock_t *stripe = stripe_of(shared, index);
+        pthread_rwlock_wrlock(stripe);
+        jarray.set(&shared->array, index, elem);
+        pthread_rwlock_unlock(stripe);
+        pthread_rwlock_unlock(&shared->structure);
+        return;
+    }
+    pthread_rwlock_unlock(&shared->structure);
+    lock_write(shared);
+    jarray.set(&shared->array, index, elem);
+    unlock_write(shared);
+}
+
+static void shared_remove_at(JARRAY_SHARED *shared, size_t index) {
+    if (!check_shared(shared, "remove from")) return;
+    lock_write(shared);
+    jarray.remove_at(&shared->array, index);
+    unlock_write(shared);
+}
+
+static void shared_clear(JARRAY_SHARED *shared) {
+    if (!check_shared(shared, "clear")) return;
+    lock_write(shared);
+    jarray.clear(&shared->array);
+    unlock_write(shared);
+}
+
+static void shared_sort(JARRAY_SHARED *shared, SORT_METHOD method, int (*custom_compare_callback)(const void*, const void*)) {
+    if (!check_shared(shared, "sort")) return;
+    lock_write(shared);
+    jarray.sort(&shared->array, method, custom_compare_callback);
+    unlock_write(shared);
+}
+
+JARRAY_SHARED_INTERFACE jarray_shared = {
+    .create = shared_create,
+    .free = shared_free,
+    .read = shared_read,
+    .write = shared_write,
+    .try_read = shared_try_read,
+    .try_write = shared_try_write,
+    .length = shared_length,
+    .get = shared_get,
+    .contains = shared_contains,
+    .index_of = shared_index_of,
+    .find_first = shared_find_first,
+    .reduce = shared_reduce,
+    .join = shared_join,
+    .snapshot = shared_snapshot,
+    .add = shared_add,
+    .set = shared_set,
+    .remove_at = shared_remove_at,
+    .clear = shared_clear,
+    .sort = shared_sort,
+};
@@ -0,0 +1,236 @@
+#include "jarray_simd.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @file jarray_simd.c
+ * @brief Vectorized compare-and-movemask scan kernels used by the numeric presets.
+ */
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__)) && defined(__SSE2__)
+#  define JARRAY_SIMD_X86
+#  include <immintrin.h>
+#endif
+
+static inline size_t scan_kind_width(JARRAY_SCAN_KIND kind) {
+    switch (kind) {
+        case JARRAY_SCAN_INT8:   return 1;
+        case JARRAY_SCAN_INT16:  return 2;
+        case JARRAY_SCAN_INT32:
+        case JARRAY_SCAN_FLOAT:  return 4;
+        case JARRAY_SCAN_INT64:
+        case JARRAY_SCAN_DOUBLE: return 8;
+        default:                 return 0;
+    }
+}
+
+static size_t find_scalar(JARRAY_SCAN_KIND kind, const unsigned char *data, size_t length, size_t start, const void *needle) {
+    if (kind == JARRAY_SCAN_FLOAT) {
+        float value;
+        memcpy(&value, needle, sizeof(value));
+        for (size_t i = start; i < length; i++) {
+            float current;
+            memcpy(&current, data + i * sizeof(float), sizeof(current));
+            if (current == value) return i;
+        }
+        return length;
+    }
+    if (kind == JARRAY_SCAN_DOUBLE) {
+        double value;
+        memcpy(&value, needle, sizeof(value));
+        for (size_t i = start; i < length; i++) {
+            double current;
+            memcpy(&current, data + i * sizeof(double), sizeof(current));
+            if (current == value) return i;
+        }
+        return length;
+    }
+
+    size_t width = scan_kind_width(kind);
+    for (size_t i = start; i < length; i++) {
+        if (memcmp(data + i * width, needle, width) == 0) return i;
+    }
+    return length;
+}
+
+#ifdef JARRAY_SIMD_X86
+
+/// Keeps the bit of the first byte of each element whose bytes all compared equal.
+static inline uint32_t fold_byte_mask(uint32_t mask, size_t width, uint32_t lanes) {
+    switch (width) {
+        case 2:
+            mask &= mask >> 1;
+            return mask & (0x55555555u & lanes);
+        case 4:
+            mask &= mask >> 1;
+            mask &= mask >> 2;
+            return mask & (0x11111111u & lanes);
+        case 8:
+            mask &= mask >> 1;
+            mask &= mask >> 2;
+            mask &= mask >> 4;
+            return mask & (0x01010101u & lanes);
+        default:
+            return mask;
+    }
+}
+
+static inline __m128i broadcast_sse2(const void *needle, size_t width) {
+    switch (width) {
+        case 1: { int8_t v;  memcpy(&v, needle, 1); return _mm_set1_epi8(v); }
+        case 2: { int16_t v; memcpy(&v, needle, 2); return _mm_set1_epi16(v); }
+        case 4: { int32_t v; memcpy(&v, needle, 4); return _mm_set1_epi32(v); }
+        default: { int64_t v; memcpy(&v, needle, 8); return _mm_set1_epi64x(v); }
+    }
+}
+
+static size_t find_int_sse2(const unsigned char *data, size_t length, size_t start, const void *needle, size_t width) {
+    const size_t per_vector = 16 / width;
+    const __m128i value = broadcast_sse2(needle, width);
+    size_t i = start;
+
+    for (; i + per_vector <= length; i += per_vector) {
+        __m128i block = _mm_loadu_si128((const __m128i *)(data + i * width));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, value));
+        mask = fold_byte_mask(mask, width, 0xFFFFu);
+        if (mask) return i + (size_t)__builtin_ctz(mask) / width;
+    }
+    for (; i < length; i++) {
+        if (memcmp(data + i * width, needle, width) == 0) return i;
+    }
+    return length;
+}
+
+static size_t find_float_sse2(const unsigned char *data, size_t length, size_t start, const void *needle) {
+    float scalar;
+    memcpy(&scalar, needle, sizeof(scalar));
+    const __m128 value = _mm_set1_ps(scalar);
+    size_t i = start;
+
+    for (; i + 4 <= length; i += 4) {
+        int mask = _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps((const float *)(data + i * 4)), value));
+        if (mask) return i + (size_t)__builtin_ctz((unsigned)mask);
+    }
+    return find_scalar(JARRAY_SCAN_FLOAT, data, length, i, needle);
+}
+
+static size_t find_double_sse2(const unsigned char *data, size_t length, size_t start, const void *needle) {
+    double scalar;
+    memcpy(&scalar, needle, sizeof(scalar));
+    const __m128d value = _mm_set1_pd(scalar);
+    size_t i = start;
+
+    for (; i + 2 <= length; i += 2) {
+        int mask = _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd((const double *)(data + i * 8)), value));
+        if (mask) return i + (size_t)__builtin_ctz((unsigned)mask);
+    }
+    return find_scalar(JARRAY_SCAN_DOUBLE, data, length, i, needle);
+}
+
+__attribute__((target("avx2")))
+static size_t find_int_avx2(const unsigned char *data, size_t length, size_t start, const void *needle, size_t width) {
+    const size_t per_vector = 32 / width;
+    __m256i value;
+    switch (width) {
+        case 1: { int8_t v;  memcpy(&v, needle, 1); value = _mm256_set1_epi8(v); break; }
+        case 2: { int16_t v; memcpy(&v, needle, 2); value = _mm256_set1_epi16(v); break; }
+        case 4: { int32_t v; memcpy(&v, needle, 4); value = _mm256_set1_epi32(v); break; }
+        default: { int64_t v; memcpy(&v, needle, 8); value = _mm256_set1_epi64x(v); break; }
+    }
+    size_t i = start;
+
+    // Two vectors per iteration: the common "no match" case only pays one branch per 64 bytes
+    for (; i + 2 * per_vector <= length; i += 2 * per_vector) {
+        __m256i eq0 = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(data + i * width)), value);
+        __m256i eq1 = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(data + (i + per_vector) * width)), value);
+        if (!_mm256_testz_si256(_mm256_or_si256(eq0, eq1), _mm256_or_si256(eq0, eq1))) {
+            uint32_t mask = fold_byte_mask((uint32_t)_mm256_movemask_epi8(eq0), width, 0xFFFFFFFFu);
+            if (mask) return i + (size_t)__builtin_ctz(mask) / width;
+            mask = fold_byte_mask((uint32_t)_mm256_movemask_epi8(eq1), width, 0xFFFFFFFFu);
+            if (mask) return i + per_vector + (size_t)__builtin_ctz(mask) / width;
+        }
+    }
+    for (; i + per_vector <= length; i += per_vector) {
+        __m256i eq = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(data + i * width)), value);
+        uint32_t mask = fold_byte_mask((uint32_t)_mm256_movemask_epi8(eq), width, 0xFFFFFFFFu);
+        if (mask) return i + (size_t)__builtin_ctz(mask) / width;
+    }
+    return find_int_sse2(data, length, i, needle, width);
+}
+
+__attribute__((target("avx2")))
+static size_t find_float_avx2(const unsigned char *data, size_t length, size_t start, const void *needle) {
+    float scalar;
+    memcpy(&scalar, needle, sizeof(scalar));
+    const __m256 value = _mm256_set1_ps(scalar);
+    size_t i = start;
+
+    for (; i + 8 <= length; i += 8) {
+        __m256 eq = _mm256_cmp_ps(_mm256_loadu_ps((const float *)(data + i * 4)), value, _CMP_EQ_OQ);
+        int mask = _mm256_movemask_ps(eq);
+        if (mask) return i + (size_t)__builtin_ctz((unsigned)mask);
+    }
+    return find_float_sse2(data, length, i, needle);
+}
+
+__attribute__((target("avx2")))
+static size_t find_double_avx2(const unsigned char *data, size_t length, size_t start, const void *needle) {
+    double scalar;
+    memcpy(&scalar, needle, sizeof(scalar));
+    const __m256d value = _mm256_set1_pd(scalar);
+    size_t i = start;
+
+    for (; i + 4 <= length; i += 4) {
+        __m256d eq = _mm256_cmp_pd(_mm256_loadu_pd((const double *)(data + i * 8)), value, _CMP_EQ_OQ);
+        int mask = _mm256_movemask_pd(eq);
+        if (mask) return i + (size_t)__builtin_ctz((unsigned)mask);
+    }
+    return find_double_sse2(data, length, i, needle);
+}
+
+#endif // JARRAY_SIMD_X86
+
+bool jarray_cpu_has_avx2(void) {
+#ifdef JARRAY_SIMD_X86
+    // Called from worker threads: threads racing on the first call all compute and store the same answer
+    static _Atomic int has_avx2 = -1;
+    int cached = atomic_load_explicit(&has_avx2, memory_order_relaxed);
+    if (cached < 0) {
+        __builtin_cpu_init();
+        cached = __builtin_cpu_supports("avx2") ? 1 : 0;
+        atomic_store_explicit(&has_avx2, cached, memory_order_relaxed);
+    }
+    return cached == 1;
+#else
+    return false;
+#endif
+}
+
+size_t jarray_scan_find(JARRAY_SCAN_KIND kind, const void *data, size_t length, size_t start, const void *needle) {
+    const unsigned char *bytes = (const unsigned char *)data;
+    if (start >= length) return length;
+
+#ifdef JARRAY_SIMD_X86
+    bool avx2 = jarray_cpu_has_avx2();
+    switch (kind) {
+        case JARRAY_SCAN_FLOAT:
+            return avx2 ? find_float_avx2(bytes, length, start, needle) : find_float_sse2(bytes, length, start, needle);
+        case JARRAY_SCAN_DOUBLE:
+            return avx2 ? find_double_avx2(bytes, length, start, needle) : find_double_sse2(bytes, length, start, needle);
+        case JARRAY_SCAN_INT8:
+        case JARRAY_SCAN_INT16:
+        case JARRAY_SCAN_INT32:
+        case JARRAY_SCAN_INT64: {
+            size_t width = scan_kind_width(kind);
+            return avx2 ? find_int_avx2(bytes, length, start, needle, width) : find_int_sse2(bytes, length, start, needle, width);
+        }
+        default:
+            return length;
+    }
+#else
+    if (kind == JARRAY_SCAN_NONE) return length;
+    return find_scalar(kind, bytes, length, start, needle);
+#endif
+}
@@ -0,0 +1,45 @@
+/**
+ * @file jarray_simd.h
+ * @brief Internal vectorized kernels of the JARRAY library. Not part of the public API.
+ */
+
+#ifndef JARRAY_SIMD_H
+#define JARRAY_SIMD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief Kind of elements a scan kernel compares.
+ * Integer kinds compare bytes (equality of integers is bitwise), float kinds follow `==` (NaN never matches, -0.0 matches 0.0).
+ */
+typedef enum JARRAY_SCAN_KIND {
+    JARRAY_SCAN_NONE = 0,
+    JARRAY_SCAN_INT8,
+    JARRAY_SCAN_INT16,
+    JARRAY_SCAN_INT32,
+    JARRAY_SCAN_INT64,
+    JARRAY_SCAN_FLOAT,
+    JARRAY_SCAN_DOUBLE,
+} JARRAY_SCAN_KIND;
+
+/**
+ * @brief Finds the first element equal to `needle` in `data[start..length)`.
+ *
+ * @note Dispatches at runtime to AVX2 or SSE2 kernels when available, scalar loop otherwise.
+ *
+ * @param kind Kind of the elements.
+ * @param data Pointer to the first element of the buffer.
+ * @param length Number of elements in the buffer.
+ * @param start Index where the search begins.
+ * @param needle Pointer to the value to find.
+ * @return index of the first match, or `length` if none.
+ */
+size_t jarray_scan_find(JARRAY_SCAN_KIND kind, const void *data, size_t length, size_t start, const void *needle);
+
+/**
+ * @brief Checks once if the CPU runs AVX2, used to pick kernel variants at runtime.
+ */
+bool jarray_cpu_has_avx2(void);
+
+#endif // JARRAY_SIMD_H
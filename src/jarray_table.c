@@ -0,0 +1,310 @@
+#include "../inc/jarray_table.h"
+#include "jarray_internal.h"
+
+/**
+ * @file jarray_table.c
+ * @brief Column table: one JARRAY per field, rows kept in sync by the table functions.
+ */
+
+static inline char* column_at(const JARRAY *column, size_t index) {
+    return (char*)column->_data + index * column->_elem_size;
+}
+
+static bool check_table(const JARRAY_TABLE *table, const char *action) {
+    if (!table) {
+        jarray_internal_error(NULL, JARRAY_INVALID_ARGUMENT, "Cannot %s a NULL JARRAY_TABLE", action);
+        return false;
+    }
+    if (!table->_columns && table->_column_count > 0) {
+        jarray_internal_error(NULL, JARRAY_UNINITIALIZED, "Cannot %s an uninitialized JARRAY_TABLE", action);
+        return false;
+    }
+    return true;
+}
+
+static bool check_column_index(const JARRAY_TABLE *table, size_t column) {
+    if (column >= table->_column_count) {
+        jarray_internal_error(NULL, JARRAY_INDEX_OUT_OF_BOUND, "Column %zu out of bound for a table of %zu columns", column, table->_column_count);
+        return false;
+    }
+    return true;
+}
+
+static void table_free(JARRAY_TABLE *table) {
+    if (!table) return;
+    for (size_t c = 0; c < table->_column_count; c++)
+        jarray.free(&table->_columns[c]);
+    free(table->_columns);
+    free(table->_layout);
+    table->_columns = NULL;
+    table->_layout = NULL;
+    table->_column_count = 0;
+    table->_length = 0;
+}
+
+static void table_init(JARRAY_TABLE *table, size_t row_size, const JARRAY_TABLE_COLUMN *columns, size_t column_count) {
+    if (!table)
+        return jarray_internal_error(NULL, JARRAY_INVALID_ARGUMENT, "Cannot initialize a NULL JARRAY_TABLE");
+    table->_columns = NULL;
+    table->_layout = NULL;
+    table->_column_count = 0;
+    table->_row_size = row_size;
+    table->_length = 0;
+    if (!columns || column_count == 0)
+        return jarray_internal_error(NULL, JARRAY_INVALID_ARGUMENT, "A JARRAY_TABLE needs at least one column");
+    for (size_t c = 0; c < column_count; c++) {
+        if (columns[c].size == 0 || columns[c].offset + columns[c].size > row_size)
+            return jarray_internal_error(NULL, JARRAY_INVALID_ARGUMENT, "Column %zu does not fit in a row of %zu bytes", c, row_size);
+    }
+
+    table->_columns = calloc(column_count, sizeof(JARRAY));
+    table->_layout = malloc(column_count * sizeof(JARRAY_TABLE_COLUMN));
+    if (!table->_columns || !table->_layout) {
+        free(table->_columns);
+        free(table->_layout);
+        table->_columns = NULL;
+        table->_layout = NULL;
+        return jarray_internal_error(NULL, JARRAY_DATA_NULL, "Memory allocation failed for table columns");
+    }
+    memcpy(table->_layout, columns, column_count * sizeof(JARRAY_TABLE_COLUMN));
+    for (size_t c = 0; c < column_count; c++) {
+        if (columns[c].preset != JARRAY_NO_PRESET) {
+            table->_columns[c] = jarray.init_preset(columns[c].preset);
+            if (!last_error_trace.has_error && table->_columns[c]._data_type != JARRAY_TYPE_VALUE)
+                jarray_internal_error(&table->_columns[c], JARRAY_INVALID_ARGUMENT, "Column %zu: table columns hold values, not pointers", c);
+            else if (!last_error_trace.has_error && table->_columns[c]._elem_size != columns[c].size)
+                jarray_internal_error(&table->_columns[c], JARRAY_INVALID_ARGUMENT, "Column %zu has size %zu but its preset elements are %zu bytes", c, columns[c].size, table->_columns[c]._elem_size);
+        } else {
+            jarray.init(&table->_columns[c], columns[c].size, JARRAY_TYPE_VALUE, (JARRAY_USER_CALLBACK_IMPLEMENTATION){0});
+        }
+        table->_column_count = c + 1;
+        if (last_error_trace.has_error) {
+            // Keep the error of the failing column, table_free does not touch the trace
+            JARRAY_RETURN error = last_error_trace;
+            table_free(table);
+            last_error_trace = error;
+            last_error_trace.ret_source = NULL;
+            return;
+        }
+    }
+    jarray_internal_reset_error();
+}
+
+/// Makes room for `capacity` rows in every column. Returns false (error set) if an allocation failed.
+static bool table_reserve(JARRAY_TABLE *table, size_t capacity) {
+    for (size_t c = 0; c < table->_column_count; c++) {
+        JARRAY *column = &table->_columns[c];
+        if (column->_capacity >= capacity) continue;
+        void *data = realloc(column->_data, capacity * column->_elem_size);
+        if (!data) {
+            jarray_internal_error(column, JARRAY_DATA_NULL, "Memory allocation failed when growing column %zu", c);
+            return false;
+        }
+        column->_data = data;
+        column->_capacity = capacity;
+    }
+    return true;
+}
+
+/// Sets the length of the table and of every column.
+static void table_set_length(JARRAY_TABLE *table, size_t length) {
+    table->_length = length;
+    for (size_t c = 0; c < table->_column_count; c++)
+        table->_columns[c]._length = length;
+}
+
+/// Columns are written directly: lookup structures attached to them would go out of sync, they are detached.
+static void table_modified(JARRAY_TABLE *table) {
+    for (size_t c = 0; c < table->_column_count; c++) {
+        if (table->_columns[c]._hash_index) jarray.detach_hash_index(&table->_columns[c]);
+        if (table->_columns[c]._bloom_filter) jarray.detach_bloom_filter(&table->_columns[c]);
+    }
+}
+
+/// Writes the fields of `row` at `index` of every column.
+static void table_scatter_row(JARRAY_TABLE *table, size_t index, const void *row) {
+    for (size_t c = 0; c < table->_column_count; c++)
+        memcpy(column_at(&table->_columns[c], index), (const char*)row + table->_layout[c].offset, table->_layout[c].size);
+}
+
+static void table_from_array(JARRAY_TABLE *table, const JARRAY *array, const JARRAY_TABLE_COLUMN *columns, size_t column_count) {
+    if (!array || array->_data_type != JARRAY_TYPE_VALUE)
+        return jarray_internal_error(array, JARRAY_INVALID_ARGUMENT, "A JARRAY_TABLE is built from a non NULL array of values");
+    table_init(table, array->_elem_size, columns, column_count);
+    if (last_error_trace.has_error) return;
+    if (array->_length == 0) return jarray_internal_reset_error();
+    if (!table_reserve(table, array->_length)) return;
+
+    // Column by column: every pass writes one contiguous column
+    for (size_t c = 0; c < table->_column_count; c++) {
+        JARRAY *column = &table->_columns[c];
+        const char *field = (const char*)array->_data + table->_layout[c].offset;
+        for (size_t i = 0; i < array->_length; i++, field += array->_elem_size)
+            memcpy(column_at(column, i), field, column->_elem_size);
+    }
+    table_set_length(table, array->_length);
+    jarray_internal_reset_error();
+}
+
+static JARRAY table_to_array(const JARRAY_TABLE *table) {
+    JARRAY result = {0};
+    if (!check_table(table, "convert")) return result;
+    jarray.init(&result, table->_row_size, JARRAY_TYPE_VALUE, (JARRAY_USER_CALLBACK_IMPLEMENTATION){0});
+    if (table->_length == 0) return result;
+    result._data = calloc(table->_length, table->_row_size);
+    if (!result._data) {
+        jarray_internal_error(NULL, JARRAY_DATA_NULL, "Memory allocation failed when converting a table");
+        return result;
+    }
+    for (size_t c = 0; c < table->_column_count; c++) {
+        const JARRAY *column = &table->_columns[c];
+        char *field = (char*)result._data + table->_layout[c].offset;
+        for (size_t i = 0; i < table->_length; i++, field += table->_row_size)
+            memcpy(field, column_at(column, i), column->_elem_size);
+    }
+    result._length = table->_length;
+    result._capacity = table->_length;
+    jarray_internal_reset_error();
+    return result;
+}
+
+static JARRAY* table_column(JARRAY_TABLE *table, size_t index) {
+    if (!check_table(table, "read a column of") || !check_column_index(table, index)) return NULL;
+    jarray_internal_reset_error();
+    return &table->_columns[index];
+}
+
+static void table_add_row(JARRAY_TABLE *table, const void *row) {
+    if (!check_table(table, "add a row to")) return;
+    if (!row)
+        return jarray_internal_error(NULL, JARRAY_INVALID_ARGUMENT, "Row cannot be NULL");
+    if (table->_column_count > 0 && table->_columns[0]._capacity == table->_length) {
+        size_t capacity = (size_t)((float)table->_length * table->_columns[0]._capacity_multiplier);
+        if (capacity <= table->_length) capacity = table->_length + 8;
+        if (!table_reserve(table, capacity)) return;
+    }
+    table_scatter_row(table, table->_length, row);
+    table_set_length(table, table->_length + 1);
+    table_modified(table);
+    jarray_internal_reset_error();
+}
+
+static void table_get_row(const JARRAY_TABLE *table, size_t index, void *row) {
+    if (!check_table(table, "read a row of")) return;
+    if (!row)
+        return jarray_internal_error(NULL, JARRAY_INVALID_ARGUMENT, "Row cannot be NULL");
+    if (index >= table->_length)
+        return jarray_internal_error(NULL, JARRAY_INDEX_OUT_OF_BOUND, "Row %zu out of bound for a table of %zu rows", index, table->_length);
+    for (size_t c = 0; c < table->_column_count; c++)
+        memcpy((char*)row + table->_layout[c].offset, column_at(&table->_columns[c], index), table->_layout[c].size);
+    jarray_internal_reset_error();
+}
+
+static void table_remove_row(JARRAY_TABLE *table, size_t index) {
+    if (!check_table(table, "remove a row from")) return;
+    if (index >= table->_length)
+        return jarray_internal_error(NULL, JARRAY_INDEX_OUT_OF_BOUND, "Row %zu out of bound for a table of %zu rows", index, table->_length);
+    for (size_t c = 0; c < table->_column_count; c++) {
+        JARRAY *column = &table->_columns[c];
+        memmove(column_at(column, index), column_at(column, index + 1), (table->_length - index - 1) * column->_elem_size);
+    }
+    table_set_length(table, table->_length - 1);
+    table_modified(table);
+    jarray_internal_reset_error();
+}
+
+/// Stable merge sort of row indexes by the values of `column`.
+static void sort_rows(const JARRAY *column, size_t *order, size_t *tmp, size_t count, int (*compare)(const void*, const void*)) {
+    if (count < 2) return;
+    size_t half = count / 2;
+    sort_rows(column, order, tmp, half, compare);
+    sort_rows(column, order + half, tmp, count - half, compare);
+    size_t i = 0, j = half, k = 0;
+    while (i < half && j < count) {
+        if (compare(column_at(column, order[j]), column_at(column, order[i])) < 0) tmp[k++] = order[j++];
+        else tmp[k++] = order[i++];
+    }
+    while (i < half) tmp[k++] = order[i++];
+    while (j < count) tmp[k++] = order[j++];
+    memcpy(order, tmp, count * sizeof(size_t));
+}
+
+static void table_sort_by_column(JARRAY_TABLE *table, size_t column, int (*compare)(const void*, const void*)) {
+    if (!check_table(table, "sort") || !check_column_index(table, column)) return;
+    if (!compare) compare = table->_columns[column].user_callbacks.compare_callback;
+    if (!compare)
+        return jarray_internal_error(&table->_columns[column], JARRAY_UNIMPLEMENTED_FUNCTION, "Sorting column %zu needs a compare function", column);
+    if (table->_length < 2) return jarray_internal_reset_error();
+
+    size_t max_elem = 0;
+    for (size_t c = 0; c < table->_column_count; c++)
+        if (table->_columns[c]._elem_size > max_elem) max_elem = table->_columns[c]._elem_size;
+    size_t *order = malloc(2 * table->_length * sizeof(size_t));
+    char *buffer = malloc(table->_length * max_elem);
+    if (!order || !buffer) {
+        free(order);
+        free(buffer);
+        return jarray_internal_error(NULL, JARRAY_DATA_NULL, "Memory allocation failed when sorting a table");
+    }
+    for (size_t i = 0; i < table->_length; i++)
+        order[i] = i;
+    sort_rows(&table->_columns[column], order, order + table->_length, table->_length, compare);
+
+    // The permutation is applied column by column through one buffer
+    for (size_t c = 0; c < table->_column_count; c++) {
+        JARRAY *col = &table->_columns[c];
+        for (size_t i = 0; i < table->_length; i++)
+            memcpy(buffer + i * col->_elem_size, column_at(col, order[i]), col->_elem_size);
+        memcpy(col->_data, buffer, table->_length * col->_elem_size);
+    }
+    free(order);
+    free(buffer);
+    table_modified(table);
+    jarray_internal_reset_error();
+}
+
+static void table_filter(JARRAY_TABLE *table, size_t column, bool (*predicate)(const void *value, const void *ctx), const void *ctx) {
+    if (!check_table(table, "filter") || !check_column_index(table, column)) return;
+    if (!predicate)
+        return jarray_internal_error(NULL, JARRAY_INVALID_ARGUMENT, "Predicate cannot be NULL");
+    if (table->_length == 0) return jarray_internal_reset_error();
+
+    // Selection pass over the tested column only, then every column is compacted
+    uint64_t *selection = calloc(table->_length / 64 + 1, sizeof(uint64_t));
+    if (!selection)
+        return jarray_internal_error(NULL, JARRAY_DATA_NULL, "Memory allocation failed when filtering a table");
+    const JARRAY *tested = &table->_columns[column];
+    for (size_t i = 0; i < table->_length; i++) {
+        if (predicate(column_at(tested, i), ctx))
+            selection[i / 64] |= (uint64_t)1 << (i % 64);
+    }
+    size_t kept = 0;
+    for (size_t c = 0; c < table->_column_count; c++) {
+        JARRAY *col = &table->_columns[c];
+        kept = 0;
+        for (size_t w = 0; w * 64 < table->_length; w++) {
+            for (uint64_t bits = selection[w]; bits; bits &= bits - 1) {
+                size_t i = w * 64 + (size_t)__builtin_ctzll(bits);
+                if (kept != i) memcpy(column_at(col, kept), column_at(col, i), col->_elem_size);
+                kept++;
+            }
+        }
+    }
+    free(selection);
+    table_set_length(table, kept);
+    table_modified(table);
+    jarray_internal_reset_error();
+}
+
+JARRAY_TABLE_INTERFACE jarray_table = {
+    .init = table_init,
+    .from_array = table_from_array,
+    .to_array = table_to_array,
+    .free = table_free,
+    .column = table_column,
+    .add_row = table_add_row,
+    .get_row = table_get_row,
+    .remove_row = table_remove_row,
+    .sort_by_column = table_sort_by_column,
+    .filter = table_filter,
+};
@@ -0,0 +1,372 @@
+#define _DEFAULT_SOURCE // sysconf(_SC_NPROCESSORS_ONLN)
+#include "jarray_thread_pool.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/**
+ * @file jarray_thread_pool.c
+ * @brief Library-owned work-stealing scheduler.
+ *
+ * Every worker owns a Chase-Lev deque: it pushes and pops tasks at the bottom (LIFO, cache friendly),
+ * idle threads steal from the top (the oldest, hence largest, pieces of work). Threads that are not workers
+ * submit tasks through a shared injection queue. A thread waiting for a task group runs pending tasks instead of blocking,
+ * which makes nested fork/join safe.
+ */
+
+#define DEQUE_CAPACITY 1024     // tasks per worker, power of two; a task spawned on a full deque runs inline
+#define IDLE_ROUNDS 64          // unsuccessful searches before an idle worker goes to sleep
+#define MAX_SPLITS 64           // halves spawned by one run_range frame (enough for any size_t range)
+
+typedef struct TASK {
+    void (*fn)(void *arg);
+    void *arg;
+    JARRAY_TASK_GROUP *group;
+    bool owned;                 // allocated by jarray_sched_spawn, freed once run
+} TASK;
+
+struct JARRAY_TASK_GROUP {
+    atomic_size_t pending;      // spawned tasks not finished yet
+};
+
+typedef struct DEQUE {
+    _Atomic int64_t top;        // next task to steal
+    char pad_top[64 - sizeof(int64_t)];
+    _Atomic int64_t bottom;     // next free slot of the owner
+    char pad_bottom[64 - sizeof(int64_t)];
+    _Atomic(TASK*) slots[DEQUE_CAPACITY];
+} DEQUE;
+
+typedef struct WORKER {
+    DEQUE deque;
+    pthread_t thread;
+    uint32_t rng;
+} WORKER;
+
+static struct {
+    pthread_mutex_t lock;       // protects the injection queue and the sleep of idle workers
+    pthread_cond_t wake;
+    WORKER *workers;
+    size_t worker_count;        // threads of the scheduler minus the caller
+    size_t created;             // workers whose thread actually started
+    size_t wanted;              // threads requested by jarray_pool_set_threads, 0 for default
+    atomic_bool started;
+    atomic_bool stop;
+    atomic_size_t queued;       // published tasks not taken yet
+    atomic_size_t sleepers;
+    TASK **injected;            // FIFO ring of tasks published by threads that are not workers
+    size_t injected_head;
+    size_t injected_count;
+    size_t injected_capacity;
+} sched = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .wake = PTHREAD_COND_INITIALIZER,
+};
+
+// Serializes the start and stop of the workers
+static pthread_mutex_t start_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static _Thread_local WORKER *current_worker;
+static _Thread_local uint32_t external_rng = 0x9E3779B9u;
+
+/* ----- CHASE-LEV DEQUE ----- */
+
+static bool deque_push(DEQUE *deque, TASK *task) {
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    if (bottom - top >= DEQUE_CAPACITY) return false;
+    atomic_store_explicit(&deque->slots[bottom & (DEQUE_CAPACITY - 1)], task, memory_order_relaxed);
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_release);
+    return true;
+}
+
+static TASK* deque_pop(DEQUE *deque) {
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&deque->bottom, bottom, memory_order_seq_cst);
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_seq_cst);
+    if (top > bottom) {
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        return NULL;
+    }
+    TASK *task = atomic_load_explicit(&deque->slots[bottom & (DEQUE_CAPACITY - 1)], memory_order_relaxed);
+    if (top == bottom) {
+        // Last task: race against the thieves for it
+        if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed))
+            task = NULL;
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    }
+    return task;
+}
+
+static TASK* deque_steal(DEQUE *deque) {
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_seq_cst);
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_seq_cst);
+    if (top >= bottom) return NULL;
+    TASK *task = atomic_load_explicit(&deque->slots[top & (DEQUE_CAPACITY - 1)], memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed))
+        return NULL;
+    return task;
+}
+
+/* ----- SCHEDULING ----- */
+
+static bool inject(TASK *task) {
+    pthread_mutex_lock(&sched.lock);
+    if (sched.injected_count == sched.injected_capacity) {
+        size_t new_cap = sched.injected_capacity ? sched.injected_capacity * 2 : 64;
+        TASK **ring = malloc(new_cap * sizeof(TASK*));
+        if (!ring) {
+            pthread_mutex_unlock(&sched.lock);
+            return false;
+        }
+        for (size_t i = 0; i < sched.injected_count; i++)
+            ring[i] = sched.injected[(sched.injected_head + i) % sched.injected_capacity];
+        free(sched.injected);
+        sched.injected = ring;
+        sched.injected_head = 0;
+        sched.injected_capacity = new_cap;
+    }
+    sched.injected[(sched.injected_head + sched.injected_count++) % sched.injected_capacity] = task;
+    pthread_mutex_unlock(&sched.lock);
+    return true;
+}
+
+static TASK* take_injected(void) {
+    TASK *task = NULL;
+    pthread_mutex_lock(&sched.lock);
+    if (sched.injected_count > 0) {
+        task = sched.injected[sched.injected_head];
+        sched.injected_head = (sched.injected_head + 1) % sched.injected_capacity;
+        sched.injected_count--;
+    }
+    pthread_mutex_unlock(&sched.lock);
+    return task;
+}
+
+static void run_task(TASK *task) {
+    JARRAY_TASK_GROUP *group = task->group;
+    task->fn(task->arg);
+    if (task->owned) free(task);
+    // Last access: the group (and a task living on the stack of the waiter) may be released right after
+    atomic_fetch_sub_explicit(&group->pending, 1, memory_order_release);
+}
+
+/// Makes a task runnable: on the deque of the current worker, through the injection queue otherwise. Runs it inline if both are full.
+static void publish(TASK *task) {
+    atomic_fetch_add(&sched.queued, 1);
+    bool queued = current_worker ? deque_push(&current_worker->deque, task) : inject(task);
+    if (!queued) {
+        atomic_fetch_sub(&sched.queued, 1);
+        run_task(task);
+        return;
+    }
+    if (atomic_load(&sched.sleepers) > 0) {
+        pthread_mutex_lock(&sched.lock);
+        pthread_cond_signal(&sched.wake);
+        pthread_mutex_unlock(&sched.lock);
+    }
+}
+
+static inline uint32_t next_random(uint32_t *state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+/// Own deque first, then the injection queue, then a steal attempt on every other worker starting at a random one.
+static TASK* find_task(void) {
+    TASK *task = NULL;
+    if (current_worker)
+        task = deque_pop(&current_worker->deque);
+    if (!task && atomic_load(&sched.queued) > 0) {
+        task = take_injected();
+        size_t count = sched.worker_count;
+        uint32_t *rng = current_worker ? &current_worker->rng : &external_rng;
+        size_t start = count ? next_random(rng) % count : 0;
+        for (size_t i = 0; !task && i < count; i++) {
+            WORKER *victim = &sched.workers[(start + i) % count];
+            if (victim != current_worker)
+                task = deque_steal(&victim->deque);
+        }
+    }
+    if (task) atomic_fetch_sub(&sched.queued, 1);
+    return task;
+}
+
+static void* worker_main(void *arg) {
+    current_worker = arg;
+    size_t idle = 0;
+    while (!atomic_load(&sched.stop)) {
+        TASK *task = find_task();
+        if (task) {
+            run_task(task);
+            idle = 0;
+            continue;
+        }
+        if (++idle < IDLE_ROUNDS) {
+            sched_yield();
+            continue;
+        }
+        pthread_mutex_lock(&sched.lock);
+        atomic_fetch_add(&sched.sleepers, 1);
+        while (atomic_load(&sched.queued) == 0 && !atomic_load(&sched.stop))
+            pthread_cond_wait(&sched.wake, &sched.lock);
+        atomic_fetch_sub(&sched.sleepers, 1);
+        pthread_mutex_unlock(&sched.lock);
+        idle = 0;
+    }
+    return NULL;
+}
+
+static size_t default_threads(void) {
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    return online > 0 ? (size_t)online : 1;
+}
+
+/// Must be called with start_lock held.
+static void sched_start(void) {
+    size_t threads = sched.wanted ? sched.wanted : default_threads();
+    if (threads > 1) {
+        sched.workers = calloc(threads - 1, sizeof(WORKER));
+        if (sched.workers) {
+            sched.worker_count = threads - 1;
+            for (size_t i = 0; i < sched.worker_count; i++) {
+                sched.workers[i].rng = (uint32_t)(i + 1) * 0x9E3779B9u;
+                if (pthread_create(&sched.workers[i].thread, NULL, worker_main, &sched.workers[i]) != 0) break;
+                sched.created++;
+            }
+            // Deques of workers that failed to start stay empty: stealing from them finds nothing
+        }
+    }
+    atomic_store(&sched.started, true);
+}
+
+/// Must be called with start_lock held, and no task running.
+static void sched_stop(void) {
+    atomic_store(&sched.stop, true);
+    pthread_mutex_lock(&sched.lock);
+    pthread_cond_broadcast(&sched.wake);
+    pthread_mutex_unlock(&sched.lock);
+    for (size_t i = 0; i < sched.created; i++)
+        pthread_join(sched.workers[i].thread, NULL);
+    free(sched.workers);
+    sched.workers = NULL;
+    sched.worker_count = 0;
+    sched.created = 0;
+    atomic_store(&sched.stop, false);
+    atomic_store(&sched.started, false);
+}
+
+static void ensure_started(void) {
+    if (atomic_load(&sched.started)) return;
+    pthread_mutex_lock(&start_lock);
+    if (!atomic_load(&sched.started)) sched_start();
+    pthread_mutex_unlock(&start_lock);
+}
+
+void jarray_pool_set_threads(size_t count) {
+    pthread_mutex_lock(&start_lock);
+    if (atomic_load(&sched.started)) sched_stop();
+    sched.wanted = count;
+    pthread_mutex_unlock(&start_lock);
+}
+
+size_t jarray_pool_threads(void) {
+    ensure_started();
+    return sched.worker_count + 1;
+}
+
+/* ----- TASK GROUPS ----- */
+
+JARRAY_TASK_GROUP* jarray_sched_group_create(void) {
+    JARRAY_TASK_GROUP *group = malloc(sizeof(JARRAY_TASK_GROUP));
+    if (group) atomic_init(&group->pending, 0);
+    return group;
+}
+
+bool jarray_sched_spawn(JARRAY_TASK_GROUP *group, void (*fn)(void *arg), void *arg) {
+    ensure_started();
+    TASK *task = malloc(sizeof(TASK));
+    if (!task) {
+        fn(arg);
+        return false;
+    }
+    *task = (TASK){ .fn = fn, .arg = arg, .group = group, .owned = true };
+    atomic_fetch_add(&group->pending, 1);
+    publish(task);
+    return true;
+}
+
+void jarray_sched_wait(JARRAY_TASK_GROUP *group) {
+    while (atomic_load_explicit(&group->pending, memory_order_acquire) > 0) {
+        TASK *task = find_task();
+        if (task) run_task(task);
+        else sched_yield();
+    }
+}
+
+void jarray_sched_group_free(JARRAY_TASK_GROUP *group) {
+    if (!group) return;
+    jarray_sched_wait(group);
+    free(group);
+}
+
+/* ----- PARALLEL RANGES ----- */
+
+typedef struct RANGE_JOB {
+    void (*fn)(size_t chunk, void *ctx);
+    void *ctx;
+} RANGE_JOB;
+
+typedef struct RANGE_TASK {
+    TASK task;
+    const RANGE_JOB *job;
+    size_t lo;
+    size_t hi;
+} RANGE_TASK;
+
+static void run_range(const RANGE_JOB *job, size_t lo, size_t hi);
+
+static void range_task_main(void *arg) {
+    RANGE_TASK *range = arg;
+    run_range(range->job, range->lo, range->hi);
+}
+
+/// Publishes the upper half of the range until one chunk is left, runs it, then joins the halves (running them if nobody stole them).
+static void run_range(const RANGE_JOB *job, size_t lo, size_t hi) {
+    JARRAY_TASK_GROUP group;
+    atomic_init(&group.pending, 0);
+    RANGE_TASK halves[MAX_SPLITS];
+    size_t splits = 0;
+    while (hi - lo > 1 && splits < MAX_SPLITS) {
+        size_t mid = lo + (hi - lo) / 2;
+        RANGE_TASK *half = &halves[splits++];
+        half->job = job;
+        half->lo = mid;
+        half->hi = hi;
+        half->task = (TASK){ .fn = range_task_main, .arg = half, .group = &group, .owned = false };
+        atomic_fetch_add(&group.pending, 1);
+        publish(&half->task);
+        hi = mid;
+    }
+    for (; lo < hi; lo++)
+        job->fn(lo, job->ctx);
+    jarray_sched_wait(&group);
+}
+
+void jarray_pool_run(size_t chunk_count, void (*fn)(size_t chunk, void *ctx), void *ctx) {
+    if (chunk_count == 0) return;
+    ensure_started();
+    if (chunk_count == 1 || sched.worker_count == 0) {
+        for (size_t chunk = 0; chunk < chunk_count; chunk++)
+            fn(chunk, ctx);
+        return;
+    }
+    RANGE_JOB job = { fn, ctx };
+    run_range(&job, 0, chunk_count);
+}
@@ -0,0 +1,63 @@
+/**
+ * @file jarray_thread_pool.h
+ * @brief Internal work-stealing scheduler running the parallel operations of the JARRAY library. Not part of the public API.
+ */
+
+#ifndef JARRAY_THREAD_POOL_H
+#define JARRAY_THREAD_POOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct JARRAY_TASK_GROUP JARRAY_TASK_GROUP;
+
+/**
+ * @brief Runs `fn(chunk, ctx)` for every chunk in `[0, chunk_count)` on the scheduler, and waits for all of them.
+ *
+ * @note
+ * The range is split recursively (fork/join): idle workers steal the largest pending halves, so chunks of uneven cost
+ * balance themselves. Can be called from a task or a chunk (nested parallelism), the caller runs tasks while it waits.
+ *
+ * @param chunk_count Number of chunks.
+ * @param fn Function processing one chunk.
+ * @param ctx Context pointer passed to fn.
+ */
+void jarray_pool_run(size_t chunk_count, void (*fn)(size_t chunk, void *ctx), void *ctx);
+
+/**
+ * @brief Sets the number of threads running tasks, the caller included (0 for the number of online processors).
+ *
+ * @note
+ * Workers are (re)started lazily by the next parallel call. Must not be called while tasks run.
+ *
+ * @param count Number of threads.
+ */
+void jarray_pool_set_threads(size_t count);
+
+/**
+ * @brief Returns the number of threads running tasks, the caller included.
+ */
+size_t jarray_pool_threads(void);
+
+/**
+ * @brief Allocates an empty task group.
+ * @return pointer to the group, NULL if allocation failed.
+ */
+JARRAY_TASK_GROUP* jarray_sched_group_create(void);
+
+/**
+ * @brief Schedules `fn(arg)` as a task of `group`. Returns false if the task could not be allocated (it is then run inline).
+ */
+bool jarray_sched_spawn(JARRAY_TASK_GROUP *group, void (*fn)(void *arg), void *arg);
+
+/**
+ * @brief Waits for every task of `group`, running pending tasks in the meantime.
+ */
+void jarray_sched_wait(JARRAY_TASK_GROUP *group);
+
+/**
+ * @brief Waits for every task of `group`, then frees it.
+ */
+void jarray_sched_group_free(JARRAY_TASK_GROUP *group);
+
+#endif // JARRAY_THREAD_POOL_H
@@ -1,6 +1,13 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
+#include <pthread.h>
+#include <sched.h>
 #include "../inc/jarray.h"
+#include "../inc/jarray_typed.h"
+#include "../inc/jarray_concurrent.h"
+#include "../inc/jarray_shared.h"
+#include "../inc/jarray_queue.h"
 
 // ----------- Helpers -----------
 
@@ -39,6 +46,10 @@ bool is_equal_int(const void *a, const void *b) {
     return JARRAY_GET_VALUE(const int, a) == JARRAY_GET_VALUE(const int, b);
 }
 
+size_t hash_int(const void *x) {
+    return jarray_hash_u64((uint64_t)JARRAY_GET_VALUE(const int, x));
+}
+
 void print_array_override(const JARRAY *array) {
     printf("Custom print of JARRAY [size: %zu]: ", array->_length);
     for (size_t i = 0; i < array->_length; i++) {
@@ -48,6 +59,11 @@ void print_array_override(const JARRAY *array) {
     printf("\n");
 }
 
+bool sup_1(const void *x, const void *ctx) {
+    (void)ctx;
+    return JARRAY_GET_VALUE(const int, x) > 1;
+}
+
 bool sup_8(const void *x, const void *ctx) {
     (void)ctx;
     return JARRAY_GET_VALUE(const int, x) > 8;
@@ -62,6 +78,84 @@ bool test_ctx_func(const void *x, const void *ctx){
     return (JARRAY_GET_VALUE(const int, x) < JARRAY_GET_VALUE(TEST_CTX, ctx).sn || JARRAY_GET_VALUE(const int, x) > JARRAY_GET_VALUE(TEST_CTX, ctx).hn);
 }
 
+// Map: half of an int, as a double
+void half(const void *x, void *out, void *ctx) {
+    (void)ctx;
+    JARRAY_GET_VALUE(double, out) = JARRAY_GET_VALUE(const int, x) / 2.0;
+}
+
+// In place accumulator for pipelines: sum of doubles
+void add_double(void *acc, const void *elem, void *ctx) {
+    (void)ctx;
+    JARRAY_GET_VALUE(double, acc) += JARRAY_GET_VALUE(const double, elem);
+}
+
+// Fold: statistics of an int array
+typedef struct INT_STATS {
+    int min;
+    int max;
+    long total;
+} INT_STATS;
+
+void int_stats(void *acc, const void *elem, void *ctx) {
+    (void)ctx;
+    INT_STATS *stats = acc;
+    int value = JARRAY_GET_VALUE(const int, elem);
+    if (value < stats->min) stats->min = value;
+    if (value > stats->max) stats->max = value;
+    stats->total += value;
+}
+
+// Combiner of partial stats computed by parallel_fold
+void merge_int_stats(void *acc, const void *partial, void *ctx) {
+    (void)ctx;
+    INT_STATS *stats = acc;
+    const INT_STATS *other = partial;
+    if (other->min < stats->min) stats->min = other->min;
+    if (other->max > stats->max) stats->max = other->max;
+    stats->total += other->total;
+}
+
+// Task: stats of a range of an int array
+typedef struct HALF_STATS {
+    JARRAY *array;
+    size_t start;
+    size_t end;
+    INT_STATS stats;
+} HALF_STATS;
+
+void half_stats_task(void *arg) {
+    HALF_STATS *half = arg;
+    for (size_t i = half->start; i < half->end; i++)
+        int_stats(&half->stats, (char*)half->array->_data + i * half->array->_elem_size, NULL);
+}
+
+void double_block(void *chunk, size_t count, size_t start_index, void *ctx) {
+    (void)start_index; (void)ctx;
+    int *values = chunk;
+    for (size_t i = 0; i < count; i++)
+        values[i] *= 2;
+}
+
+JARRAY_DEFINE(int, jarray_i32)
+
+bool is_odd(int value, void *ctx) {
+    (void)ctx;
+    return value % 2 != 0;
+}
+
+size_t write_to_file(const char *data, size_t size, void *ctx) {
+    return fwrite(data, 1, size, (FILE*)ctx);
+}
+
+size_t first_above_block(const void *chunk, size_t count, size_t start_index, const void *ctx) {
+    (void)start_index;
+    const int *values = chunk;
+    for (size_t i = 0; i < count; i++)
+        if (values[i] > JARRAY_GET_VALUE(const int, ctx)) return i;
+    return count;
+}
+
 void *sum(const void *accumulator, const void *elem, const void *ctx) {
     (void)ctx;
     int *result = malloc(sizeof(int));
@@ -69,6 +163,87 @@ void *sum(const void *accumulator, const void *elem, const void *ctx) {
     return result;
 }
 
+// Concurrent array writer: pushes `count` values from `first`, one by one then in batches
+typedef struct APPEND_WORKER {
+    JARRAY_CONCURRENT *array;
+    int first;
+    size_t count;
+} APPEND_WORKER;
+
+void *append_writer(void *arg) {
+    APPEND_WORKER *worker = arg;
+    int batch[8];
+    size_t done = 0;
+    for (; done < worker->count / 2; done++)
+        jarray_concurrent.push(worker->array, JARRAY_DIRECT_INPUT(int, worker->first + (int)done));
+    while (done < worker->count) {
+        size_t n = worker->count - done < 8 ? worker->count - done : 8;
+        for (size_t i = 0; i < n; i++)
+            batch[i] = worker->first + (int)(done + i);
+        jarray_concurrent.push_n(worker->array, batch, n);
+        done += n;
+    }
+    return NULL;
+}
+
+// Concurrent array reader: walks the published prefix while it grows, counts elements out of [0, expected)
+typedef struct APPEND_READER {
+    JARRAY_CONCURRENT *array;
+    size_t expected;
+    size_t invalid;
+} APPEND_READER;
+
+void *append_reader(void *arg) {
+    APPEND_READER *reader = arg;
+    for (size_t seen = 0; seen < reader->expected;) {
+        size_t length = jarray_concurrent.length(reader->array);
+        if (length == seen) sched_yield(); // nothing new published yet
+        for (; seen < length; seen++) {
+            int *elem = jarray_concurrent.at(reader->array, seen);
+            if (!elem || *elem < 0 || (size_t)*elem >= reader->expected) reader->invalid++;
+        }
+    }
+    return NULL;
+}
+
+// Queue worker: producers push `count` values from `first`, consumers pop `count` values and sum them
+typedef struct QUEUE_WORKER {
+    JARRAY_QUEUE *queue;
+    int first;
+    size_t count;
+    long long total;
+} QUEUE_WORKER;
+
+void *queue_producer(void *arg) {
+    QUEUE_WORKER *worker = arg;
+    int batch[16];
+    for (size_t done = 0; done < worker->count;) {
+        size_t n = worker->count - done < 16 ? worker->count - done : 16;
+        for (size_t i = 0; i < n; i++)
+            batch[i] = worker->first + (int)(done + i);
+        for (size_t pushed = 0; pushed < n;) {
+            size_t step = jarray_queue.push_n(worker->queue, batch + pushed, n - pushed);
+            if (step == 0) sched_yield(); // full: let a consumer run
+            pushed += step;
+        }
+        done += n;
+    }
+    return NULL;
+}
+
+void *queue_consumer(void *arg) {
+    QUEUE_WORKER *worker = arg;
+    int batch[16];
+    for (size_t done = 0; done < worker->count;) {
+        size_t step = jarray_queue.pop_n(worker->queue, batch, worker->count - done < 16 ? worker->count - done : 16);
+        if (step == 0) sched_yield(); // empty: let a producer run
+        for (size_t i = 0; i < step; i++)
+            worker->total += batch[i];
+        done += step;
+    }
+    return NULL;
+}
+
 int main(void) {
     JARRAY array;
 
@@ -81,7 +256,7 @@ int main(void) {
         data_start[i-1] = i;
     }
 
-    JARRAY_USER_CALLBACK_IMPLEMENTATION imp;
+    JARRAY_USER_CALLBACK_IMPLEMENTATION imp = {0};
 
     imp.print_element_callback = print_int;
     imp.element_to_string_callback = int_to_string;
@@ -119,6 +294,39 @@ int main(void) {
     jarray.print(&filtered);
     if (JARRAY_CHECK_RET) return EXIT_FAILURE;
     jarray.free(&filtered); // free filtered array
+
+    printf("\nFiltering even numbers into a reused destination:\n");
+    JARRAY evens_buffer;
+    jarray.init(&evens_buffer, sizeof(int), JARRAY_TYPE_VALUE, imp);
+    JARRAY_CHECK_RET;
+    for (int tick = 0; tick < 3; tick++) {
+        jarray.filter_into(&array, &evens_buffer, is_even, NULL); // allocates on the first tick only
+        JARRAY_CHECK_RET;
+    }
+    jarray.print(&evens_buffer);
+    jarray.free(&evens_buffer);
+
+    // --- Mapping ---
+    printf("\nMapping numbers to their half (double preset):\n");
+    JARRAY halves = jarray.map_preset(&array, JARRAY_DOUBLE_PRESET, half, NULL);
+    JARRAY_CHECK_RET;
+    jarray.print(&halves);
+    jarray.free(&halves);
+
+    // --- Pipeline ---
+    printf("\nSum of the halves of the 3 first even numbers (lazy pipeline, no intermediate array): ");
+    double halves_sum = 0;
+    JARRAY_PIPELINE *pipeline = jarray.pipeline(&array);
+    pipeline = jarray.pipeline_filter(pipeline, is_even, NULL);
+    pipeline = jarray.pipeline_take(pipeline, 3);
+    pipeline = jarray.pipeline_map(pipeline, sizeof(double), half, NULL);
+    jarray.pipeline_reduce(pipeline, &halves_sum, add_double, NULL);
+    JARRAY_CHECK_RET;
+    printf("%.2f\n", halves_sum);
+    printf("Collect the int pipeline into a double array (should indicate error, sizes differ)\n");
+    JARRAY mismatched = jarray.pipeline_collect_preset(jarray.pipeline(&array), JARRAY_DOUBLE_PRESET);
+    JARRAY_CHECK_RET;
+    jarray.free(&mismatched);
     // --- Sorting ---
     printf("\nSorting array:\n");
     jarray.sort(&array, QSORT, NULL);
@@ -185,6 +393,12 @@ int main(void) {
     printf("%zu\n", indexes[0]);
     free(indexes);
 
+    printf("Count of 12: %zu, as a jarray: ", jarray.count_of(&array, JARRAY_DIRECT_INPUT(int, 12)));
+    JARRAY indexes_12 = jarray.indexes_of_jarray(&array, JARRAY_DIRECT_INPUT(int, 12));
+    JARRAY_CHECK_RET;
+    jarray.print(&indexes_12);
+    jarray.free(&indexes_12);
+
     // --- For each ---
     printf("\nFor each element, modulo 3:\n");
     jarray.for_each(&array, modulo3, NULL);
@@ -220,6 +434,10 @@ int main(void) {
     printf("Joined string: %s\n", joined_str);
     free(joined_str);
     joined_str = NULL;
+    printf("Streamed to stdout: ");
+    jarray.write_to(&clone, "-", write_to_file, stdout);
+    JARRAY_CHECK_RET;
+    printf("\n");
 
     // --- Reduce ---
     printf("\nReducing clone array (sum of elements): ");
@@ -237,12 +455,217 @@ int main(void) {
     free(reduced);
     reduced = NULL;
 
+    // --- Fold ---
+    printf("\nFolding clone array into min/max/total stats: ");
+    INT_STATS stats = {INT_MAX, INT_MIN, 0};
+    jarray.fold(&clone, &stats, int_stats, NULL);
+    JARRAY_CHECK_RET;
+    printf("min = %d, max = %d, total = %ld\n", stats.min, stats.max, stats.total);
+
+    // --- Parallel operations ---
+    printf("\nSame stats with parallel_fold on 4 threads: ");
+    jarray.set_thread_count(4);
+    INT_STATS identity = {INT_MAX, INT_MIN, 0}, parallel_stats = identity;
+    jarray.parallel_fold(&clone, &parallel_stats, sizeof(parallel_stats), &identity, int_stats, merge_int_stats, NULL);
+    JARRAY_CHECK_RET;
+    printf("min = %d, max = %d, total = %ld\n", parallel_stats.min, parallel_stats.max, parallel_stats.total);
+    printf("First index of an element > 1 (parallel): %zu\n", jarray.parallel_find_first_index(&clone, sup_1, NULL));
+    JARRAY_CHECK_RET;
+    JARRAY sorted_clone = jarray.clone(&clone);
+    JARRAY_CHECK_RET;
+    jarray.parallel_sort(&sorted_clone, NULL);
+    JARRAY_CHECK_RET;
+    printf("Parallel sort of a copy of clone: ");
+    jarray.print(&sorted_clone);
+    jarray.free(&sorted_clone);
+
+    // --- Tasks ---
+    printf("Folding both halves of clone in two tasks: ");
+    HALF_STATS halves_stats[2] = {{&clone, 0, clone._length / 2, {INT_MAX, INT_MIN, 0}},
+                                  {&clone, clone._length / 2, clone._length, {INT_MAX, INT_MIN, 0}}};
+    JARRAY_TASK_GROUP *group = jarray.task_group_create();
+    JARRAY_CHECK_RET;
+    jarray.task_spawn(group, half_stats_task, &halves_stats[0]);
+    jarray.task_spawn(group, half_stats_task, &halves_stats[1]);
+    jarray.task_group_free(group); // waits for both tasks
+    printf("totals %ld and %ld\n", halves_stats[0].stats.total, halves_stats[1].stats.total);
+
+    // --- Numeric kernels ---
+    JARRAY numbers = jarray.init_preset(JARRAY_INT_PRESET);
+    for (size_t i = 0; i < clone._length; i++)
+        jarray.add(&numbers, jarray.at(&clone, i));
+    int inline_total = 0;
+    for (size_t i = 0; i < jarray_len(&numbers); i++)
+        inline_total += JARRAY_AT(int, &numbers, i);
+    printf("\nSum through the inline accessors: %d\n", inline_total);
+    jarray_i32 typed = jarray_i32_wrap(jarray.clone(&numbers));
+    JARRAY_CHECK_RET;
+    jarray_i32_sort(&typed);
+    jarray_i32 odds = jarray_i32_filter(&typed, is_odd, NULL);
+    printf("\nTyped array sorted, odd values: ");
+    jarray.print(&odds.base);
+    jarray_i32_free(&odds);
+    jarray_i32_free(&typed);
+    JARRAY_CONCURRENT *appended = jarray_concurrent.create_preset(JARRAY_INT_PRESET);
+    JARRAY_CHECK_RET;
+    jarray_concurrent.push_n(appended, jarray_data(&numbers), jarray_len(&numbers));
+    jarray_concurrent.push(appended, JARRAY_DIRECT_INPUT(int, 100));
+    JARRAY_CHECK_RET;
+    JARRAY appended_copy = jarray_concurrent.to_array(appended);
+    printf("\nConcurrent append-only array, %zu published elements: ", jarray_concurrent.length(appended));
+    jarray.print(&appended_copy);
+    jarray.free(&appended_copy);
+    jarray_concurrent.free(appended);
+    enum { APPEND_THREADS = 4, APPEND_PER_THREAD = 5000 };
+    appended = jarray_concurrent.create_preset(JARRAY_INT_PRESET);
+    JARRAY_CHECK_RET;
+    APPEND_WORKER writers[APPEND_THREADS];
+    APPEND_READER reader = {appended, APPEND_THREADS * APPEND_PER_THREAD, 0};
+    pthread_t append_threads[APPEND_THREADS + 1];
+    pthread_create(&append_threads[APPEND_THREADS], NULL, append_reader, &reader);
+    for (int t = 0; t < APPEND_THREADS; t++) {
+        writers[t] = (APPEND_WORKER){appended, t * APPEND_PER_THREAD, APPEND_PER_THREAD};
+        pthread_create(&append_threads[t], NULL, append_writer, &writers[t]);
+    }
+    for (int t = 0; t <= APPEND_THREADS; t++)
+        pthread_join(append_threads[t], NULL);
+    // Every value pushed must be there exactly once, whatever the interleaving
+    size_t appended_length = jarray_concurrent.length(appended);
+    bool *pushed_once = calloc(reader.expected, sizeof(bool));
+    size_t duplicates = 0;
+    for (size_t i = 0; pushed_once && i < appended_length; i++) {
+        int value = JARRAY_GET_VALUE(int, jarray_concurrent.at(appended, i));
+        if (value < 0 || (size_t)value >= reader.expected || pushed_once[value]) duplicates++;
+        else pushed_once[value] = true;
+    }
+    bool appended_ok = pushed_once && appended_length == reader.expected && duplicates == 0 && reader.invalid == 0;
+    printf("%d concurrent writers and a reader: %zu elements (expected %zu), %zu invalid reads, %zu duplicates: %s\n", APPEND_THREADS, appended_length, reader.expected, reader.invalid, duplicates, appended_ok ? "ok" : "MISMATCH");
+    free(pushed_once);
+    jarray_concurrent.free(appended);
+    if (!appended_ok) return EXIT_FAILURE;
+    JARRAY_SHARED *shared = jarray_shared.create(jarray.clone(&numbers), 4);
+    JARRAY_CHECK_RET;
+    jarray_shared.set(shared, 0, JARRAY_DIRECT_INPUT(int, 42));
+    JARRAY_CHECK_RET;
+    int shared_first;
+    jarray_shared.get(shared, 0, &shared_first);
+    JARRAY_CHECK_RET;
+    printf("\nShared array: first element %d, contains 42: %s\n", shared_first, jarray_shared.contains(shared, JARRAY_DIRECT_INPUT(int, 42)) ? "true" : "false");
+    jarray_shared.free(shared);
+    JARRAY_QUEUE *queue = jarray_queue.create_preset(JARRAY_INT_PRESET, 8, JARRAY_QUEUE_SPSC);
+    JARRAY_CHECK_RET;
+    size_t queued = jarray_queue.push_n(queue, jarray_data(&numbers), jarray_len(&numbers));
+    int queue_out[8];
+    size_t dequeued = jarray_queue.pop_n(queue, queue_out, 8);
+    printf("\nQueue of capacity %zu: %zu pushed, %zu popped, first %d\n", jarray_queue.capacity(queue), queued, dequeued, dequeued > 0 ? queue_out[0] : 0);
+    jarray_queue.free(queue);
+    enum { QUEUE_THREADS = 3, QUEUE_PER_THREAD = 2000 };
+    queue = jarray_queue.create_preset(JARRAY_INT_PRESET, 64, JARRAY_QUEUE_MPMC);
+    JARRAY_CHECK_RET;
+    QUEUE_WORKER producers[QUEUE_THREADS], consumers[QUEUE_THREADS];
+    pthread_t queue_threads[2 * QUEUE_THREADS];
+    for (int t = 0; t < QUEUE_THREADS; t++) {
+        producers[t] = (QUEUE_WORKER){queue, t * QUEUE_PER_THREAD, QUEUE_PER_THREAD, 0};
+        consumers[t] = (QUEUE_WORKER){queue, 0, QUEUE_PER_THREAD, 0};
+        pthread_create(&queue_threads[2 * t], NULL, queue_producer, &producers[t]);
+        pthread_create(&queue_threads[2 * t + 1], NULL, queue_consumer, &consumers[t]);
+    }
+    long long queue_total = 0;
+    for (int t = 0; t < QUEUE_THREADS; t++) {
+        pthread_join(queue_threads[2 * t], NULL);
+        pthread_join(queue_threads[2 * t + 1], NULL);
+        queue_total += consumers[t].total;
+    }
+    long long queue_expected = (long long)QUEUE_THREADS * QUEUE_PER_THREAD * (QUEUE_THREADS * QUEUE_PER_THREAD - 1) / 2;
+    printf("MPMC queue, %d producers and %d consumers: sum %lld (expected %lld), %zu left: %s\n", QUEUE_THREADS, QUEUE_THREADS, queue_total, queue_expected, jarray_queue.length(queue), queue_total == queue_expected && jarray_queue.length(queue) == 0 ? "ok" : "MISMATCH");
+    jarray_queue.free(queue);
+    if (queue_total != queue_expected) return EXIT_FAILURE;
+    printf("\nBuffered print of the INT preset copy:\n");
+    jarray.print_to(&numbers, stdout);
+    JARRAY_CHECK_RET;
+    long long numbers_sum;
+    jarray.sum(&numbers, &numbers_sum);
+    JARRAY_CHECK_RET;
+    printf("\nSum of clone: %lld, mean: %.2f, max: %d at index %zu\n", numbers_sum, jarray.mean(&numbers), JARRAY_GET_VALUE(int, jarray.max(&numbers)), jarray.argmax(&numbers));
+    JARRAY scaled = jarray.clone(&numbers);
+    JARRAY_CHECK_RET;
+    jarray.axpy(&scaled, JARRAY_DIRECT_INPUT(int, 2), &numbers);
+    JARRAY_CHECK_RET;
+    jarray.clamp(&scaled, JARRAY_DIRECT_INPUT(int, 1), JARRAY_DIRECT_INPUT(int, 4));
+    JARRAY_CHECK_RET;
+    printf("clone * 3 clamped to [1, 4]: ");
+    jarray.print(&scaled);
+    jarray.scan(&numbers, &scaled, JARRAY_SCAN_SUM, true);
+    JARRAY_CHECK_RET;
+    printf("Running sum of clone: ");
+    jarray.print(&scaled);
+    jarray.parallel_scan(&numbers, NULL, JARRAY_SCAN_MAX, false);
+    JARRAY_CHECK_RET;
+    printf("Exclusive running max of clone (parallel, in place): ");
+    jarray.print(&numbers);
+    size_t bins[3];
+    jarray.histogram(&scaled, 1, 1, 3, bins);
+    JARRAY_CHECK_RET;
+    printf("Histogram of the running sum over [1, 4): %zu ones, %zu twos, %zu threes\n", bins[0], bins[1], bins[2]);
+    JARRAY_GROUP_BY_PARAMS distinct = { .entry_size = sizeof(int), .key_size = sizeof(int), .agg_offset = sizeof(int) };
+    JARRAY groups = jarray.group_by(&scaled, &distinct);
+    JARRAY_CHECK_RET;
+    printf("Distinct values of the running sum:");
+    for (size_t i = 0; i < groups._length; i++)
+        printf(" %d", ((int*)groups._data)[i]);
+    printf("\n");
+    jarray.free(&groups);
+    jarray.for_each_chunk(&scaled, 4, double_block, NULL);
+    JARRAY_CHECK_RET;
+    printf("Running sum doubled by blocks of 4: ");
+    jarray.print(&scaled);
+    int above = 10;
+    printf("First value above 10, searched by blocks: %d\n", JARRAY_GET_VALUE(int, jarray.find_first_chunk(&scaled, 4, first_above_block, &above)));
+    JARRAY_CHECK_RET;
+    jarray.free(&scaled);
+    jarray.free(&numbers);
+
     // --- Contains ---
     printf("\nChecking if clone contains 5: ");
     bool contains = jarray.contains(&clone, JARRAY_DIRECT_INPUT(int, 5));
     JARRAY_CHECK_RET;
     printf("%s\n", contains ? "Yes" : "No");
 
+    // --- Hash index ---
+    printf("\nAttaching a hash index to clone and searching 5 again: ");
+    clone.user_callbacks.hash_callback = hash_int;
+    jarray.attach_hash_index(&clone);
+    JARRAY_CHECK_RET;
+    jarray.add(&clone, JARRAY_DIRECT_INPUT(int, 42)); // the index follows the modifications of the array
+    JARRAY_CHECK_RET;
+    size_t index_42 = jarray.index_of(&clone, JARRAY_DIRECT_INPUT(int, 42));
+    JARRAY_CHECK_RET;
+    printf("%s, 42 is at index %zu\n", jarray.contains(&clone, JARRAY_DIRECT_INPUT(int, 5)) ? "Yes" : "No", index_42);
+    jarray.remove(&clone);
+    JARRAY_CHECK_RET;
+    jarray.detach_hash_index(&clone);
+    JARRAY_CHECK_RET;
+
+    // --- Bloom filter ---
+    printf("\nAttaching a bloom filter to clone, contains 1000 ? ");
+    jarray.attach_bloom_filter(&clone, 0);
+    JARRAY_CHECK_RET;
+    printf("%s\n", jarray.contains(&clone, JARRAY_DIRECT_INPUT(int, 1000)) ? "Yes" : "No"); // answered without scanning
+    jarray.detach_bloom_filter(&clone);
+    JARRAY_CHECK_RET;
+
+    // --- Batch lookups ---
+    int probes[] = {2, 1000, 0, 7};
+    uint64_t present = 0;
+    size_t probe_indexes[4];
+    jarray.contains_many(&clone, probes, 4, &present);
+    JARRAY_CHECK_RET;
+    jarray.index_of_many(&clone, probes, 4, probe_indexes);
+    JARRAY_CHECK_RET;
+    printf("\nBatch lookup of 2, 1000, 0, 7 in clone:\n");
+    for (size_t k = 0; k < 4; k++)
+        printf("%d: %s (index %zu)\n", probes[k], (present >> k) & 1 ? "present" : "absent", probe_indexes[k]);
+
     // --- Remove all ---
     printf("\nRemoving all elements that are in clone from original array:\n");
     jarray.add(&array, JARRAY_DIRECT_INPUT(int, 17)); // add 17 to original array for testing